@@ -65,6 +65,7 @@
 #include "ns3/flysafe-onoff.h"
 #include "ns3/flysafe-packet-sink.h"
 #include "ns3/flysafe-tag.h"
+#include "ns3/flysafe-neighbor-table.h"
 #include "ns3/flysafe-statistics.h"
 #include "ns3/utils.h"
 
@@ -270,7 +271,7 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
   int i;
 
   for(i=0; i < (int)nNodes; i++) {
-     Nodes.Get(i)->SetState(0);
+     FlySafeNeighborTable::Install(Nodes.Get(i))->SetState(0);
   }
 
 
@@ -284,7 +285,7 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
   NS_LOG_INFO("FlySafe - Generate and set malicious nodes ...");
 
   for(i=0; i < nMalicious; i++) {
-     Nodes.Get(malicious[i])->SetState(1);
+     FlySafeNeighborTable::Install(Nodes.Get(malicious[i]))->SetState(1);
      cout << "Setting node 192.168.1." << malicious[i]+1 << " as malicious!" << endl; // << endl;
   }
 
@@ -310,7 +311,7 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
 
     SinkApp->SetStartTime(Seconds(start));
     SinkApp->SetStopTime(Seconds(stop));
-    if((*it)->GetState() == 0){ //Ordinary node
+    if((*it)->GetObject<FlySafeNeighborTable>()->GetState() == 0){ //Ordinary node
       SinkApp->Setup(SinkBroadAddress, 1, 9999.99); // 1 -> UDP, 2 -> TCP
     }
     else {
@@ -336,7 +337,7 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
     (*it)->AddApplication(OnOffApp); 
     
 
-    if((*it)->GetState() == 0){ //Ordinary node
+    if((*it)->GetObject<FlySafeNeighborTable>()->GetState() == 0){ //Ordinary node
       OnOffApp->Setup(InetSocketAddress(Ipv4Address("255.255.255.255"), 9),
                     1, 9999.99); // 1 -> UDP, 2 -> TCP
     }
@@ -462,6 +463,22 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
                     MakeCallback(&Statistics::SenderMaliciousCallback, &statistics));
   }
 
+  // Callback Trace to Collect the position error of the quantized tags
+  // Installed in all nodes
+  for (it = Nodes.Begin(); it != Nodes.End(); it++) {
+    uint32_t nodeID = (*it)->GetId();
+    ostringstream paramTest;
+    paramTest << "/NodeList/" << (nodeID)
+              << "/ApplicationList/*/$ns3::FlySafeOnOff/QuantizationTraces";
+    Config::Connect(paramTest.str().c_str(),
+                    MakeCallback(&Statistics::QuantizationErrorCallback, &statistics));
+    paramTest.str("");
+    paramTest << "/NodeList/" << (nodeID)
+              << "/ApplicationList/*/$ns3::FlySafePacketSink/QuantizationTraces";
+    Config::Connect(paramTest.str().c_str(),
+                    MakeCallback(&Statistics::QuantizationErrorCallback, &statistics));
+  }
+
   wifiPhy.EnablePcap("flysafe", Nodes); //false);
 
   //Network Animation using NetAnim.
@@ -483,6 +500,7 @@ void FlySafeSimulation(uint32_t nNodes, string simDate, char runMode, int nMalic
 
   statistics.MessageResumeLogFile(simDate);
   statistics.MaliciousControlResumeLogFile(simDate);
+  statistics.QuantizationResumeLogFile(simDate);
 
   //----------------------------------------------------------------------------------
   // Tracing
@@ -510,6 +528,12 @@ int main(int argc, char *argv[]) {
   string simTime;
   char runMode;
   int nMalicious;
+  string positionEncoding = "Double";
+  bool trapDelta = false;
+  uint32_t payloadSize = 8;
+  double alertBatchDelay = 0;
+  string messageTransport = "Tag";
+  uint32_t trapBroadcastThreshold = 0;
   
   
   set<char> runModeSet = {'R','M'};
@@ -524,8 +548,27 @@ int main(int argc, char *argv[]) {
   cmd.AddValue("nNodes", "Number of node devices", nNodes);
   cmd.AddValue("runMode", "Mode of simulation execution", runMode);
   cmd.AddValue("nMalicious", "Number of malicious nodes", nMalicious);
+  cmd.AddValue("positionEncoding", "Positions in the tags: Double, Centimeters or Relative", 
+               positionEncoding);
+  cmd.AddValue("trapDelta", "Send only NL changes in trap messages", trapDelta);
+  cmd.AddValue("payloadSize", "Payload size of the FlySafe messages (bytes)", payloadSize);
+  cmd.AddValue("alertBatchDelay", "Time suspect alerts are held to be sent together (s)", alertBatchDelay);
+  cmd.AddValue("messageTransport", "FlySafe messages as a Tag (no airtime) or as a Header", 
+               messageTransport);
+  cmd.AddValue("trapBroadcastThreshold", "Trap targets beyond which traps are broadcast (0: never)", 
+               trapBroadcastThreshold);
   cmd.Parse(argc, argv);
 
+  Config::SetDefault("ns3::FlySafeOnOff::PositionEncoding", StringValue(positionEncoding));
+  Config::SetDefault("ns3::FlySafePacketSink::PositionEncoding", StringValue(positionEncoding));
+  Config::SetDefault("ns3::FlySafeOnOff::TrapDeltaUpdates", BooleanValue(trapDelta));
+  Config::SetDefault("ns3::FlySafeOnOff::PayloadSize", UintegerValue(payloadSize));
+  Config::SetDefault("ns3::FlySafePacketSink::PayloadSize", UintegerValue(payloadSize));
+  Config::SetDefault("ns3::FlySafePacketSink::AlertBatchDelay", TimeValue(Seconds(alertBatchDelay)));
+  Config::SetDefault("ns3::FlySafeOnOff::MessageTransport", StringValue(messageTransport));
+  Config::SetDefault("ns3::FlySafePacketSink::MessageTransport", StringValue(messageTransport));
+  Config::SetDefault("ns3::FlySafeOnOff::TrapBroadcastThreshold", UintegerValue(trapBroadcastThreshold));
+
   if (nNodes < 2 ) {
     cout << "FlySafe - Error: Number of nodes must be greater than 1!\n" 
          << "Example: ./waf --run \"scratch/flysafe.cc -nNodes=4 -runMode=R\" > results.txt"
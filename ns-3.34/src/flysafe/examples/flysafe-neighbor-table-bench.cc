@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+/*
+ * Micro-benchmark of the FlySafe neighbor table (NL)
+ *
+ * Replays the access pattern of FlySafePacketSink when a NL is received
+ * (IsAlreadyNeighbor, GetNeighborDistance, UpdateNeighbor for every entry),
+ * followed by the removal of every entry, against:
+ *
+ *  - linear: the original vector scanned on every access
+ *  - table:  the hash indexed FlySafeNeighborTable
+ *
+ * Usage: ./waf --run "flysafe-neighbor-table-bench --rounds=200"
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/flysafe-neighbor-table.h"
+
+using namespace ns3;
+
+/**
+ * Copy of the neighbor list as it was kept in ns3::Node before the
+ * hash index: a vector scanned from the beginning on every access.
+ */
+class LinearNeighborTable
+{
+public:
+  struct Neighbor
+  {
+    Ipv4Address ip;
+    Vector position;
+    double distance;
+    uint8_t attitude;
+    uint8_t quality;
+    uint8_t hop;
+    uint8_t state;
+  };
+
+  void RegisterNeighbor (Ipv4Address ip, Vector position, double distance, uint8_t attitude,
+                         uint8_t quality, uint8_t hop, uint8_t state)
+  {
+    Neighbor neighbor = {ip, position, distance, attitude, quality, hop, state};
+    m_neighborList.push_back (neighbor);
+  }
+
+  void UnregisterNeighbor (Ipv4Address ip)
+  {
+    for (std::vector<Neighbor>::iterator i = m_neighborList.begin (); i != m_neighborList.end (); i++)
+      {
+        if (i->ip == ip)
+          {
+            m_neighborList.erase (i);
+            break;
+          }
+      }
+  }
+
+  void UpdateNeighbor (Ipv4Address ip, Vector position, double distance, uint8_t attitude,
+                       uint8_t quality, uint8_t hop)
+  {
+    for (std::vector<Neighbor>::iterator i = m_neighborList.begin (); i != m_neighborList.end (); i++)
+      {
+        if (i->ip == ip)
+          {
+            i->position = position;
+            i->distance = distance;
+            i->attitude = attitude;
+            i->quality = quality;
+            i->hop = hop;
+            break;
+          }
+      }
+  }
+
+  double GetNeighborDistance (Ipv4Address ip)
+  {
+    for (std::vector<Neighbor>::iterator i = m_neighborList.begin (); i != m_neighborList.end (); i++)
+      {
+        if (i->ip == ip)
+          {
+            return i->distance;
+          }
+      }
+    return 0;
+  }
+
+  bool IsAlreadyNeighbor (Ipv4Address ip)
+  {
+    for (std::vector<Neighbor>::iterator i = m_neighborList.begin (); i != m_neighborList.end (); i++)
+      {
+        if (i->ip == ip)
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+private:
+  std::vector<Neighbor> m_neighborList;
+};
+
+/**
+ * Run the NL workload over a table and return the elapsed time in microseconds
+ */
+template <typename Table>
+double
+RunWorkload (Table &table, const std::vector<Ipv4Address> &ips, uint32_t rounds)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  double checksum = 0;
+
+  for (uint32_t n = 0; n < ips.size (); n++)
+    {
+      table.RegisterNeighbor (ips[n], Vector (n, n, 91), n, 0, 3, 1, 0);
+    }
+
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      // Walk the entries in reverse order so the linear table does not
+      // benefit from finding recent entries first
+      for (uint32_t n = ips.size (); n-- > 0; )
+        {
+          if (table.IsAlreadyNeighbor (ips[n]))
+            {
+              double oldDistance = table.GetNeighborDistance (ips[n]);
+              checksum += oldDistance;
+              table.UpdateNeighbor (ips[n], Vector (n + r, n, 91), oldDistance + 1, 1, 1, 2);
+            }
+        }
+    }
+
+  for (uint32_t n = 0; n < ips.size (); n++)
+    {
+      table.UnregisterNeighbor (ips[n]);
+    }
+
+  std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now ();
+  if (checksum < 0)
+    {
+      std::cout << checksum << std::endl; // Keep the loop from being optimized away
+    }
+  return std::chrono::duration<double, std::micro> (stop - start).count ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t rounds = 100;
+
+  CommandLine cmd;
+  cmd.AddValue ("rounds", "Number of NL updates replayed for each table size", rounds);
+  cmd.Parse (argc, argv);
+
+  uint32_t sizes[] = {10, 100, 1000};
+
+  std::cout << std::setw (8) << "entries" << std::setw (16) << "linear (us)"
+            << std::setw (16) << "table (us)" << std::setw (10) << "speedup" << std::endl;
+
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+    {
+      std::vector<Ipv4Address> ips;
+      for (uint32_t n = 0; n < sizes[s]; n++)
+        {
+          ips.push_back (Ipv4Address (Ipv4Address ("10.0.0.1").Get () + n));
+        }
+
+      LinearNeighborTable linear;
+      Ptr<FlySafeNeighborTable> table = CreateObject<FlySafeNeighborTable> ();
+
+      double linearTime = RunWorkload (linear, ips, rounds);
+      double tableTime = RunWorkload (*table, ips, rounds);
+
+      std::cout << std::setw (8) << sizes[s] << std::fixed << std::setprecision (1)
+                << std::setw (16) << linearTime << std::setw (16) << tableTime
+                << std::setw (9) << linearTime / tableTime << "x" << std::endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+/*
+ * Micro-benchmark of the MyTag (de)serialization
+ *
+ * Serializes a tag carrying a NL and deserializes it back, as done once
+ * per sent and received FlySafe message, for NL sizes from 0 to 1000
+ * entries, with:
+ *
+ *  - legacy: the original copy through stack arrays of padded structs
+ *  - tag:    MyTag, streamed field by field into the vector
+ *
+ * Usage: ./waf --run "flysafe-tag-bench --rounds=1000"
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/flysafe-tag.h"
+
+using namespace ns3;
+
+/**
+ * NL entry as it was before the packed encoding, without the information
+ * time added since, so the legacy baseline keeps its original 40 bytes
+ */
+struct LegacyNeighInfos
+{
+  Ipv4Address ip;
+  double x;
+  double y;
+  double z;
+  uint8_t hop;
+  uint8_t state;
+};
+
+/**
+ * Copy of MyTag (de)serialization as it was before the packed encoding:
+ * two variable length arrays on the stack, a memcpy through both and a
+ * push_back per entry.
+ */
+class LegacyTag
+{
+public:
+  uint32_t GetSerializedSize (void) const
+  {
+    return sizeof (Vector) + sizeof (uint8_t) + sizeof (uint32_t) + (sizeof (LegacyNeighInfos) * m_nNeighborsValue) + sizeof (double);
+  }
+
+  void Serialize (TagBuffer i) const
+  {
+    i.WriteU8 (2);
+    i.WriteDouble (0);
+    i.WriteU32 (m_nNeighborsValue);
+    i.WriteDouble (0);
+    i.WriteDouble (0);
+    i.WriteDouble (91);
+
+    struct LegacyNeighInfos nInfos[m_nNeighborsValue];
+    uint32_t j = 0;
+    for (auto n : m_neighInfosVector)
+      {
+        nInfos[j++] = n;
+      }
+    unsigned char temp3[sizeof (LegacyNeighInfos) * m_nNeighborsValue];
+    std::memcpy (temp3, nInfos, sizeof (LegacyNeighInfos) * m_nNeighborsValue);
+    i.Write (temp3, sizeof (LegacyNeighInfos) * m_nNeighborsValue);
+  }
+
+  void Deserialize (TagBuffer i)
+  {
+    i.ReadU8 ();
+    i.ReadDouble ();
+    m_nNeighborsValue = i.ReadU32 ();
+    i.ReadDouble ();
+    i.ReadDouble ();
+    i.ReadDouble ();
+
+    struct LegacyNeighInfos nInfos[m_nNeighborsValue];
+    unsigned char temp3[sizeof (LegacyNeighInfos) * m_nNeighborsValue];
+    i.Read (temp3, sizeof (LegacyNeighInfos) * m_nNeighborsValue);
+    std::memcpy (&nInfos, &temp3, sizeof (LegacyNeighInfos) * m_nNeighborsValue);
+    m_neighInfosVector.clear ();
+    for (auto n : nInfos)
+      {
+        m_neighInfosVector.push_back (n);
+      }
+  }
+
+  void SetNNeighbors (uint32_t nNeighbors)
+  {
+    m_nNeighborsValue = nNeighbors;
+  }
+
+  uint32_t GetNNeighbors (void)
+  {
+    return m_nNeighborsValue;
+  }
+
+  void SetNeighInfosVector (const std::vector<MyTag::NeighInfos> &neighInfosVector)
+  {
+    m_neighInfosVector.clear ();
+    for (auto n : neighInfosVector)
+      {
+        LegacyNeighInfos entry;
+        entry.ip = n.ip;
+        entry.x = n.x;
+        entry.y = n.y;
+        entry.z = n.z;
+        entry.hop = n.hop;
+        entry.state = n.state;
+        m_neighInfosVector.push_back (entry);
+      }
+  }
+
+private:
+  uint32_t m_nNeighborsValue;
+  std::vector<LegacyNeighInfos> m_neighInfosVector;
+};
+
+/**
+ * Serialize and deserialize a tag and return the elapsed time in microseconds
+ */
+template <typename Tag>
+double
+RunWorkload (const std::vector<MyTag::NeighInfos> &entries, uint32_t rounds, uint32_t &bytes)
+{
+  Tag sent;
+  Tag received;
+  sent.SetNNeighbors (entries.size ());
+  sent.SetNeighInfosVector (entries);
+  bytes = sent.GetSerializedSize ();
+  std::vector<uint8_t> buffer (bytes);
+  uint64_t checksum = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      sent.Serialize (TagBuffer (buffer.data (), buffer.data () + bytes));
+      received.Deserialize (TagBuffer (buffer.data (), buffer.data () + bytes));
+      checksum += received.GetNNeighbors ();
+    }
+  std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now ();
+
+  if (checksum != (uint64_t) rounds * entries.size ())
+    {
+      std::cout << "Neighbors lost in the tag" << std::endl;
+    }
+  return std::chrono::duration<double, std::micro> (stop - start).count ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t rounds = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue ("rounds", "Number of tag round trips for each NL size", rounds);
+  cmd.Parse (argc, argv);
+
+  uint32_t sizes[] = {0, 10, 100, 250, 500, 1000};
+
+  std::cout << std::setw (8) << "entries" << std::setw (14) << "legacy (B)" << std::setw (12) << "tag (B)"
+            << std::setw (16) << "legacy (us)" << std::setw (14) << "tag (us)" << std::setw (10) << "speedup"
+            << std::endl;
+
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+    {
+      std::vector<MyTag::NeighInfos> entries (sizes[s]);
+      for (uint32_t n = 0; n < sizes[s]; n++)
+        {
+          entries[n].ip = Ipv4Address (Ipv4Address ("10.0.0.1").Get () + n);
+          entries[n].x = n;
+          entries[n].y = n;
+          entries[n].z = 91;
+          entries[n].hop = 1 + n % 3;
+          entries[n].state = 0;
+          entries[n].infoTime = 0;
+        }
+
+      uint32_t legacyBytes;
+      uint32_t tagBytes;
+      double legacyTime = RunWorkload<LegacyTag> (entries, rounds, legacyBytes);
+      double tagTime = RunWorkload<MyTag> (entries, rounds, tagBytes);
+
+      std::cout << std::setw (8) << sizes[s] << std::setw (14) << legacyBytes << std::setw (12) << tagBytes
+                << std::fixed << std::setprecision (1)
+                << std::setw (16) << legacyTime << std::setw (14) << tagTime
+                << std::setw (9) << (tagTime > 0 ? legacyTime / tagTime : 0) << "x" << std::endl;
+    }
+
+  return 0;
+}
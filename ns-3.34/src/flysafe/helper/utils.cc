@@ -106,9 +106,9 @@ double CalculateNodesDistance(Vector myPosition, Vector neighPosition) {
  * @date Feb 26, 2023
  */
 
-void PrintNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos) {
+void PrintNeighborList(const std::vector<ns3::MyTag::NeighInfos> &neighInfos) {
 
-  for(auto n :neighInfos){
+  for(const auto &n :neighInfos){
     cout << n.ip << " : Position x: " << n.x << " y: " << n.y << " z: " << n.z << " hop: " << (int)n.hop << endl;
   }
   cout << "\n" << endl;
@@ -120,10 +120,10 @@ void PrintNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos) {
  * @date Nov 02, 2023
  */
 
-void PrintMaliciousNodeInfo(std::vector<ns3::MyTag::NeighInfos> neighInfos) {
+void PrintMaliciousNodeInfo(const std::vector<ns3::MyTag::NeighInfos> &neighInfos) {
 
   cout << "Information received about a malicious node:" << endl;
-  for(auto n :neighInfos){
+  for(const auto &n :neighInfos){
     cout << n.ip << " : Position x: " << n.x << " y: " << n.y << " z: " << n.z << " hop: " << (int)n.hop << endl;
   }
   cout << "\n" << endl;
@@ -204,11 +204,11 @@ convertIntVectorToString(const std::vector<int>& vec) {
  * 
  * @date Nov 23, 2023
  * 
- * @param vec - IPv4 vector
+ * @param vec - IPv4 vector or view
  * @return std::string - String separated by commas
  */
 std::string 
-convertIPVectorToString(const std::vector<ns3::Ipv4Address>& vec) {
+convertIPVectorToString(ns3::Ipv4AddressRange vec) {
     std::stringstream ss;
     for (size_t i = 0; i < vec.size(); i++) {
         ss << vec[i];
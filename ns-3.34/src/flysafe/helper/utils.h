@@ -17,6 +17,7 @@
 #include "sys/stat.h"
 #include "ns3/simulator.h"
 #include "ns3/flysafe-tag.h"
+#include "ns3/ipv4-address-range.h"
 
 using namespace std;
 
@@ -73,7 +74,7 @@ CalculateNodesDistance(Vector myPosition, Vector neighPosition);
  * @date Feb 26, 2023
  */
 
-void PrintNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos);
+void PrintNeighborList(const std::vector<ns3::MyTag::NeighInfos> &neighInfos);
 
 
 /**
@@ -81,7 +82,7 @@ void PrintNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos);
  * @date Nov 02, 2023
  */
 
-void PrintMaliciousNodeInfo(std::vector<ns3::MyTag::NeighInfos> neighInfos);
+void PrintMaliciousNodeInfo(const std::vector<ns3::MyTag::NeighInfos> &neighInfos);
 
 /**
  * @brief Generate false location data
@@ -114,11 +115,11 @@ convertIntVectorToString(const std::vector<int>& vec);
  * 
  * @date Nov 23, 2023
  * 
- * @param vec - IPv4 vector
+ * @param vec - IPv4 vector or view
  * @return std::string - String separated by commas
  */
 std::string 
-convertIPVectorToString(const std::vector<ns3::Ipv4Address>& vec);
+convertIPVectorToString(ns3::Ipv4AddressRange vec);
 
 void Create2DPlotFile ();
 }
\ No newline at end of file
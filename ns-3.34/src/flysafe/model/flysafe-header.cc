@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <vector>
+
+#include "flysafe-header.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (FlySafeHeader);
+
+/// Bytes of the MyTag length written before it
+static const uint32_t LENGTH_SIZE = 2;
+
+const uint32_t FlySafeHeader::MAX_MESSAGE_SIZE;
+
+FlySafeHeader::FlySafeHeader ()
+{
+}
+
+FlySafeHeader::FlySafeHeader (const MyTag &tag)
+  : m_tag (tag)
+{
+}
+
+TypeId
+FlySafeHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FlySafeHeader")
+    .SetParent<Header> ()
+    .AddConstructor<FlySafeHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+FlySafeHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+FlySafeHeader::GetSerializedSize (void) const
+{
+  return LENGTH_SIZE + m_tag.GetSerializedSize ();
+}
+
+uint32_t
+FlySafeHeader::GetMaxNeighbors (MyTag::PositionEncoding encoding)
+{
+  return MyTag::GetMaxNeighInfos (encoding, MAX_MESSAGE_SIZE);
+}
+
+void
+FlySafeHeader::Serialize (Buffer::Iterator start) const
+{
+  // A UDP datagram is shorter than 64 KiB, and so is any message it carries.
+  // The applications limit the NL to GetMaxNeighbors entries when they start
+  uint32_t size = m_tag.GetSerializedSize ();
+  NS_ABORT_MSG_IF (size > MAX_MESSAGE_SIZE, "FlySafe message of " << size << " bytes too large for a header");
+
+  std::vector<uint8_t> bytes (size);
+  m_tag.Serialize (TagBuffer (bytes.data (), bytes.data () + size));
+  start.WriteHtonU16 ((uint16_t) size);
+  start.Write (bytes.data (), size);
+}
+
+uint32_t
+FlySafeHeader::Deserialize (Buffer::Iterator start)
+{
+  if (start.GetRemainingSize () < LENGTH_SIZE)
+    {
+      return 0;
+    }
+  uint32_t size = start.ReadNtohU16 ();
+  if (start.GetRemainingSize () < size)
+    {
+      return 0; // Not a FlySafe message, or a truncated one
+    }
+
+  std::vector<uint8_t> bytes (size);
+  start.Read (bytes.data (), size);
+  if (MyTag::GetWireSize (bytes.data (), size) != size)
+    {
+      return 0; // The length and the message do not match
+    }
+  m_tag.Deserialize (TagBuffer (bytes.data (), bytes.data () + size));
+  return LENGTH_SIZE + size;
+}
+
+void
+FlySafeHeader::Print (std::ostream &os) const
+{
+  os << "value=" << (uint32_t) m_tag.GetSimpleValue ()
+     << " time=" << m_tag.GetMessageTime ()
+     << " entries=" << m_tag.GetNeighInfosVector ().size ();
+}
+
+void
+FlySafeHeader::SetTag (const MyTag &tag)
+{
+  m_tag = tag;
+}
+
+const MyTag &
+FlySafeHeader::GetTag (void) const
+{
+  return m_tag;
+}
+
+MyTag &
+FlySafeHeader::GetTag (void)
+{
+  return m_tag;
+}
+
+} // namespace ns3
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef FLYSAFE_HEADER_H
+#define FLYSAFE_HEADER_H
+
+#include <stdint.h>
+
+#include "ns3/header.h"
+#include "flysafe-tag.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief FlySafe message carried in the packet bytes.
+ *
+ * Packet tags are simulation metadata and take no airtime. This header
+ * carries the same content as MyTag, with the same encoding, in the
+ * packet itself, so the channel sees the real size of each message.
+ * The MyTag bytes are preceded by their length. A message that does not
+ * fit in the packet or in its length is read as 0 bytes.
+ */
+class FlySafeHeader : public Header
+{
+public:
+  /**
+   * \brief How the applications carry a FlySafe message
+   */
+  enum Transport
+  {
+    TRANSPORT_TAG = 0,   //!< MyTag packet tag, no airtime
+    TRANSPORT_HEADER = 1 //!< FlySafeHeader in the packet bytes
+  };
+
+  FlySafeHeader ();
+  /**
+   * \param tag Message to carry
+   */
+  FlySafeHeader (const MyTag &tag);
+
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual void Print (std::ostream &os) const;
+
+  /// Largest message the length before it can describe
+  static const uint32_t MAX_MESSAGE_SIZE = 0xffff;
+
+  /**
+   * \param encoding Position encoding of the messages
+   * \return the most NL entries a header can carry
+   */
+  static uint32_t GetMaxNeighbors (MyTag::PositionEncoding encoding);
+
+  /**
+   * \param tag Message to carry
+   */
+  void SetTag (const MyTag &tag);
+  /**
+   * \return the message carried
+   */
+  const MyTag &GetTag (void) const;
+  /**
+   * \return the message carried, to move its NL out
+   */
+  MyTag &GetTag (void);
+
+private:
+  MyTag m_tag; //!< Message carried
+};
+
+} // namespace ns3
+
+#endif /* FLYSAFE_HEADER_H */
@@ -0,0 +1,1664 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "flysafe-neighbor-table.h"
+#include "neighbor-scan.h"
+#include "neighbor-snapshot.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FlySafeNeighborTable");
+
+NS_OBJECT_ENSURE_REGISTERED (FlySafeNeighborTable);
+
+TypeId
+FlySafeNeighborTable::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FlySafeNeighborTable")
+    .SetParent<Object> ()
+    .SetGroupName ("FlySafe")
+    .AddConstructor<FlySafeNeighborTable> ()
+    .AddAttribute ("NeighborMaxAge",
+                   "Time after which a neighbor that was not heard is removed "
+                   "from the NL. Zero disables the expiry.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&FlySafeNeighborTable::m_neighborMaxAge),
+                   MakeTimeChecker ())
+    .AddAttribute ("NeighborExpiryResolution",
+                   "Granularity of the neighbor expiry.",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&FlySafeNeighborTable::m_neighborExpiryResolution),
+                   MakeTimeChecker (MilliSeconds (1)))
+    .AddAttribute ("MaxNeighbors",
+                   "Maximum number of entries in the NL. When full, the stalest, "
+                   "farthest, highest hop entry makes room for a better one. "
+                   "Zero means no limit.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlySafeNeighborTable::m_maxNeighbors),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+FlySafeNeighborTable::FlySafeNeighborTable ()
+  : m_neighborsVersion (0),
+    m_maxNeighbors (0),
+    m_state (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FlySafeNeighborTable::~FlySafeNeighborTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+/**
+ * @brief Get the table of a node, aggregating a new one if needed
+ * @date Feb 12, 2024
+ *
+ * @param node - The node
+ * @return Ptr<FlySafeNeighborTable> - Table aggregated to node
+ */
+
+Ptr<FlySafeNeighborTable>
+FlySafeNeighborTable::Install (Ptr<Node> node)
+{
+  Ptr<FlySafeNeighborTable> table = node->GetObject<FlySafeNeighborTable> ();
+  if (table == 0)
+    {
+      table = CreateObject<FlySafeNeighborTable> ();
+      node->AggregateObject (table);
+    }
+  return table;
+}
+
+void
+FlySafeNeighborTable::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_neighborSnapshot = 0;
+  m_expiryEvent.Cancel ();
+  Object::DoDispose ();
+}
+
+/**
+ * @brief Order neighbor entries by how much they are worth keeping
+ * @date Feb 14, 2024
+ *
+ * Suspicious entries are kept while there is an ordinary one to drop,
+ * as the traps depend on them. Otherwise the stalest entry goes first
+ * (lowest quality, then oldest information), then the farthest, then
+ * the one with the highest hop.
+ *
+ * @return bool - True if a should leave the NL before b
+ */
+
+static bool
+NeighborEvictsBefore (const struct FlySafeNeighborTable::Neighbor &a, const struct FlySafeNeighborTable::Neighbor &b)
+{
+  if ((a.state == 0) != (b.state == 0))
+    {
+      return a.state == 0;
+    }
+  if (a.quality != b.quality)
+    {
+      return a.quality < b.quality;
+    }
+  if (a.infoTime != b.infoTime)
+    {
+      return a.infoTime < b.infoTime;
+    }
+  if (a.distance != b.distance)
+    {
+      return a.distance > b.distance;
+    }
+  return a.hop > b.hop;
+}
+
+/**
+ * @brief Register one node as neighbor in node's neighbor list
+ * 
+ * @param ip Neighbor node IPv4 address
+ * @param position Neighbor node position (x, y, z)
+ * @param distance Neighbor node distance from node
+ * @param attitude Neighbor node attitude (0 - keep distance, 1 - inbound, 2 - outbound)
+ * @param quality Neighbor node presence (3 - Connected, 2 - Lost connection 1, 1 - Lost connection 2, 0 - Lost)
+ * @param hop Neighbor hop
+ * @param state Neighbor state (0 ordinary, 1 malicious)
+ * @return bool - False if the NL is full of entries better than this one
+ */
+
+bool
+FlySafeNeighborTable::RegisterNeighbor (Ipv4Address ip, Vector position, double distance, uint8_t attitude, uint8_t quality, uint8_t hop, uint8_t state) //, double time)
+{
+  NS_LOG_FUNCTION (this);
+  struct FlySafeNeighborTable::Neighbor neighbor;
+
+  neighbor.ip = ip;
+  neighbor.position = position;
+  neighbor.distance = distance;
+  neighbor.attitude = attitude;
+  neighbor.quality = quality;
+  neighbor.hop = hop;
+  neighbor.state = state;
+  neighbor.infoTime = Simulator::Now ().GetSeconds ();
+  return InsertNeighbor (neighbor);
+}
+
+
+/**
+ * @brief Register one neighbor entry, keeping its information time
+ * @date Feb 25, 2024 - Expiry counted from the entry information time, so a
+ * relayed entry does not live a full NeighborMaxAge from its admission
+ *
+ * @param neighbor Neighbor entry, with the time it was last heard
+ * @return bool - False if the NL is full of entries better than this one
+ */
+
+bool
+FlySafeNeighborTable::InsertNeighbor (const struct FlySafeNeighborTable::Neighbor &neighbor)
+{
+  NS_LOG_FUNCTION (this << neighbor.ip);
+  Ipv4Address ip = neighbor.ip;
+
+  m_neighborsVersion++;
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND) // Registered twice, keep a single entry
+    {
+      SetNeighborPosition (slot, neighbor.position);
+      StoreNeighbor (slot, neighbor);
+      return true;
+    }
+  if (m_maxNeighbors != 0 && m_neighbors.ip.size () >= m_maxNeighbors) // NL full - Feb 14, 24
+    {
+      uint32_t victim = FindEvictionCandidate ();
+      if (!NeighborEvictsBefore (LoadNeighbor (victim), neighbor))
+        {
+          NS_LOG_LOGIC ("NL full, " << ip << " not registered");
+          return false;
+        }
+      NS_LOG_LOGIC ("NL full, " << m_neighbors.ip[victim] << " evicted for " << ip);
+      UnregisterNeighbor (m_neighbors.ip[victim]);
+    }
+  m_neighborIndex.Insert (ip, m_neighbors.ip.size ());
+  m_neighbors.ip.push_back (ip);
+  m_neighbors.x.push_back (neighbor.position.x);
+  m_neighbors.y.push_back (neighbor.position.y);
+  m_neighbors.z.push_back (neighbor.position.z);
+  m_neighbors.distance.push_back (neighbor.distance);
+  m_neighbors.attitude.push_back (neighbor.attitude);
+  m_neighbors.quality.push_back (neighbor.quality);
+  m_neighbors.hop.push_back (neighbor.hop);
+  m_neighbors.state.push_back (neighbor.state);
+  m_neighbors.infoTime.push_back (neighbor.infoTime);
+  m_neighbors.expiry.push_back (0);
+  if (IsNeighborExpiryEnabled ())
+    {
+      ScheduleNeighborExpiry (m_neighbors.ip.size () - 1, GetExpiryTick (Seconds (neighbor.infoTime) + m_neighborMaxAge));
+    }
+  return true;
+}
+
+
+/**
+ * @brief Choose the NL entry to drop when the NL is full
+ * @date Feb 14, 2024
+ *
+ * @return uint32_t - Position in the NL of the entry to evict
+ */
+
+uint32_t
+FlySafeNeighborTable::FindEvictionCandidate (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_neighbors.ip.empty ());
+  uint32_t victim = 0;
+  struct FlySafeNeighborTable::Neighbor worst = LoadNeighbor (0);
+  for (uint32_t slot = 1; slot < m_neighbors.ip.size (); slot++)
+    {
+      struct FlySafeNeighborTable::Neighbor candidate = LoadNeighbor (slot);
+      if (NeighborEvictsBefore (candidate, worst))
+        {
+          victim = slot;
+          worst = candidate;
+        }
+    }
+  return victim;
+}
+
+
+/**
+ * @brief Order entries of a ranking, best first, the NL entries before the
+ * candidates on ties
+ * @date Feb 25, 2024
+ */
+
+struct NeighborKeptBefore
+{
+  NeighborKeptBefore (const std::vector<struct FlySafeNeighborTable::Neighbor> &ranked, uint32_t nRegistered)
+    : m_ranked (ranked),
+      m_nRegistered (nRegistered)
+  {
+  }
+
+  bool operator() (uint32_t a, uint32_t b) const
+  {
+    if (NeighborEvictsBefore (m_ranked[b], m_ranked[a]))
+      {
+        return true;
+      }
+    return !NeighborEvictsBefore (m_ranked[a], m_ranked[b]) && a < m_nRegistered && b >= m_nRegistered;
+  }
+
+  const std::vector<struct FlySafeNeighborTable::Neighbor> &m_ranked; //!< NL entries, then candidates
+  uint32_t m_nRegistered;                                             //!< Number of NL entries
+};
+
+/**
+ * @brief Register the best of some unknown nodes in a full NL
+ * @date Feb 25, 2024
+ *
+ * The NL and the candidates are ranked together once and the best
+ * MaxNeighbors entries are kept, as registering the candidates one by one
+ * would, without searching the NL for its worst entry for each of them.
+ *
+ * @param candidates - Unknown nodes, with their information time
+ * @return uint32_t - Number of candidates registered
+ */
+
+uint32_t
+FlySafeNeighborTable::AdmitNeighbors (const std::vector<struct FlySafeNeighborTable::Neighbor> &candidates)
+{
+  NS_LOG_FUNCTION (this << candidates.size ());
+  uint32_t nRegistered = m_neighbors.ip.size ();
+  std::vector<struct FlySafeNeighborTable::Neighbor> ranked;
+  ranked.reserve (nRegistered + candidates.size ());
+  for (uint32_t slot = 0; slot < nRegistered; slot++)
+    {
+      ranked.push_back (LoadNeighbor (slot));
+    }
+  ranked.insert (ranked.end (), candidates.begin (), candidates.end ());
+
+  std::vector<uint32_t> order (ranked.size ());
+  for (uint32_t i = 0; i < order.size (); i++)
+    {
+      order[i] = i;
+    }
+  uint32_t keep = std::min ((uint32_t) order.size (), m_maxNeighbors);
+  std::nth_element (order.begin (), order.begin () + keep, order.end (), NeighborKeptBefore (ranked, nRegistered));
+
+  for (uint32_t i = keep; i < order.size (); i++)
+    {
+      if (order[i] < nRegistered)
+        {
+          NS_LOG_LOGIC ("NL full, " << ranked[order[i]].ip << " evicted");
+          UnregisterNeighbor (ranked[order[i]].ip);
+        }
+    }
+  uint32_t registered = 0;
+  for (uint32_t i = 0; i < keep; i++)
+    {
+      if (order[i] >= nRegistered)
+        {
+          InsertNeighbor (ranked[order[i]]);
+          registered++;
+        }
+    }
+  return registered;
+}
+
+
+/**
+ * @brief Get node's neighbors IP addresses
+ * 
+ * @return std::vector<Ipv4Address> - List with node's neighbor IP addresses
+ */
+
+std::vector<Ipv4Address>
+FlySafeNeighborTable::GetNeighborIpList ()
+{
+  NS_LOG_FUNCTION (this);
+  return m_neighbors.ip;
+}
+
+/**
+ * @brief Get a view of node's neighbors IP addresses
+ * @date Jan 30, 2024
+ *
+ * Nothing is copied. The view is invalidated when a neighbor is
+ * registered or removed.
+ *
+ * @return Ipv4AddressRange - Node's neighbor IP addresses, in NL order
+ */
+
+Ipv4AddressRange
+FlySafeNeighborTable::GetNeighborIps () const
+{
+  return Ipv4AddressRange (m_neighbors.ip);
+}
+
+
+/**
+ * @brief Remove a node from nodes' neighbor list
+ * @param ip Neighbor IP address
+ */
+void
+FlySafeNeighborTable::UnregisterNeighbor (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot == Ipv4AddressIndex::NOT_FOUND) // checks if is already a neighbor
+    {
+      return;
+    }
+
+  m_neighborsVersion++;
+  // Move the last entry into the freed slot, so removal is O(1)
+  uint32_t last = m_neighbors.ip.size () - 1;
+  if (slot != last)
+    {
+      MoveNeighbor (last, slot);
+      m_neighborIndex.Insert (m_neighbors.ip[slot], slot);
+    }
+  ResizeNeighbors (last);
+  m_neighborIndex.Erase (ip);
+}
+
+
+/**
+ * @brief Update the position of a neighbor node
+ * 
+ * @date Nov 10, 2022
+ */
+void
+FlySafeNeighborTable::UpdateNeighbor (Ipv4Address ip, Vector position, double distance, 
+                      uint8_t attitude, uint8_t quality, uint8_t hop) //, uint8_t state) //, double time)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      SetNeighborPosition (slot, position);
+      m_neighbors.distance[slot] = distance;
+      m_neighbors.attitude[slot] = attitude;
+      m_neighbors.quality[slot] = quality;
+      m_neighbors.hop[slot] = hop;
+      //m_neighbors.state[slot] = state;
+      m_neighbors.infoTime[slot] = Simulator::Now ().GetSeconds ();
+    }
+}
+
+
+/**
+ * @brief Get the position of a neighbor node
+ * @date Nov 11, 2022
+ */
+Vector
+FlySafeNeighborTable::GetNeighborPosition (Ipv4Address ip)
+{
+  Vector position;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      position = Vector (m_neighbors.x[slot], m_neighbors.y[slot], m_neighbors.z[slot]);
+    }
+  return position;
+}
+
+
+/**
+ * @brief Get the distance of a neighbor node
+ * @date Dez 29, 2022
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return double - Neighbor node old distance
+ */
+double
+FlySafeNeighborTable::GetNeighborDistance (Ipv4Address ip)
+{
+  double distance = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      distance = m_neighbors.distance[slot];
+    }
+  return distance;
+}
+
+
+/**
+ * @brief Get the attitude of a neighbor node
+ * @date Dez 29, 2022
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return uint8_t - Neighbor node attitude
+ */
+uint8_t
+FlySafeNeighborTable::GetNeighborAttitude (Ipv4Address ip)
+{
+  uint8_t attitude = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      attitude = m_neighbors.attitude[slot];
+    }
+  return attitude;
+}
+
+
+/**
+ * @brief Set the attitude of a neighbor node
+ * @date Jan 2, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @param attitude - Neighbor node new attitude
+ */
+void
+FlySafeNeighborTable::SetNeighborAttitude (Ipv4Address ip, u_int8_t attitude)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      m_neighbors.attitude[slot] = attitude;
+    }
+}
+
+
+/**
+ * @brief Get the quality of a neighbor node
+ * @date Dez 29, 2022
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return uint8_t - Neighbor node quality
+ */
+uint8_t
+FlySafeNeighborTable::GetNeighborQuality (Ipv4Address ip)
+{
+  uint8_t quality = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      quality = m_neighbors.quality[slot];
+    }
+  return quality;
+}
+
+/**
+ * @brief Set the quality of a neighbor node
+ * @date jan 2, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @param quality - Neighbor node new quality
+ */
+void
+FlySafeNeighborTable::SetNeighborQuality (Ipv4Address ip, uint8_t quality)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      m_neighbors.quality[slot] = quality;
+    }
+}
+
+
+/**
+ * @brief Get the hop of a neighbor node
+ * @date Mar 5, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return uint8_t - Neighbor node hop
+ */
+uint8_t
+FlySafeNeighborTable::GetNeighborHop (Ipv4Address ip)
+{
+  uint8_t hop = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      hop = m_neighbors.hop[slot];
+    }
+  return hop;
+}
+
+/**
+ * @brief Set the hop of a neighbor node
+ * @date Mar 5, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @param hop - Neighbor node new hop
+ */
+void
+FlySafeNeighborTable::SetNeighborHop (Ipv4Address ip, uint8_t hop)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      m_neighbors.hop[slot] = hop;
+    }
+}
+
+/**
+ * @brief Get a neighbor node state
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return bool - Neighbor node state (0 ordinary, 1 malicious)
+ */
+uint8_t
+FlySafeNeighborTable::GetNeighborNodeState (Ipv4Address ip)
+{
+  uint8_t state = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      state = m_neighbors.state[slot];
+    }
+  return state;
+}
+
+/**
+ * @brief Set a neighbor node state
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @param state - Neighbor node state (0 ordinary, 1 malicious)
+ */
+void
+FlySafeNeighborTable::SetNeighborNodeState (Ipv4Address ip, uint8_t state)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      m_neighbors.state[slot] = state;
+    }
+}
+
+/**
+ * @brief Get all the information of a neighbor node with a single lookup
+ * @date Jan 17, 2024
+ *
+ * @param ip - Neighbor node IPv4 address
+ * @param neighbor - Entry filled with the neighbor node information
+ * @return true - ip is a neighbor and neighbor was filled
+ * @return false - ip is not a neighbor
+ */
+bool
+FlySafeNeighborTable::FindNeighbor (Ipv4Address ip, struct FlySafeNeighborTable::Neighbor &neighbor) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot == Ipv4AddressIndex::NOT_FOUND)
+    {
+      return false;
+    }
+  neighbor = LoadNeighbor (slot);
+  return true;
+}
+
+/**
+ * @brief Get a neighbor entry by its position in the NL
+ * @date Jan 17, 2024
+ *
+ * Allows walking the whole NL in one pass, together with GetNNeighbors.
+ *
+ * @param index - Entry position (0 to GetNNeighbors () - 1)
+ * @return Neighbor - Neighbor node information
+ */
+struct FlySafeNeighborTable::Neighbor
+FlySafeNeighborTable::GetNeighbor (uint32_t index) const
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT_MSG (index < m_neighbors.ip.size (), "Neighbor index " << index << " out of range");
+  return LoadNeighbor (index);
+}
+
+/**
+ * @brief Get the last time a neighbor node was heard
+ * @date Mar 5, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @return double - Neighbor node information time (s), 0 if ip is not a neighbor
+ */
+
+double
+FlySafeNeighborTable::GetNeighborInfoTime (Ipv4Address ip)
+{
+  double time = 0;
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      time = m_neighbors.infoTime[slot];
+    }
+  return time;
+}
+
+
+/**
+ * @brief Set the information time of a neighbor node
+ * @date Mar 5, 2023
+ * 
+ * @param ip - Neighbor node IPv4 address
+ * @param time - Neighbor node new information Time (s)
+ */
+
+void
+FlySafeNeighborTable::SetNeighborInfoTime (Ipv4Address ip, double time)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_neighborIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_neighborsVersion++;
+      m_neighbors.infoTime[slot] = time;
+    }
+}
+
+/**
+ * @brief Verify if node has neighbors
+ * 
+ * @return true - Node has neighbors
+ * @return false - Node has no neighbors
+ */
+bool
+FlySafeNeighborTable::IsThereAnyNeighbor ()
+{
+  NS_LOG_FUNCTION (this);
+  return !m_neighbors.ip.empty ();
+}
+
+
+/**
+ * @brief Verify if there is at least one 1 hop in NL
+ * 
+ * @return true - Node has a 1 hop neighbor
+ * @return false - Node has no 1 hop neighbors
+ */
+bool
+FlySafeNeighborTable::IsThereAnyNeighbor (uint8_t hop)
+{
+  NS_LOG_FUNCTION (this);
+  return NeighborScan::AnyEqual (m_neighbors.hop.data (), m_neighbors.hop.size (), hop);
+}
+
+
+/**
+ * @brief Verify if a node is neighbor of this one
+ * 
+ * @param ip Node IPv4 address
+ * @return true - Node is already a neighbor
+ * @return false - Node is not a neigbhor yet
+ */
+
+bool
+FlySafeNeighborTable::IsAlreadyNeighbor (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  return m_neighborIndex.Find (ip) != Ipv4AddressIndex::NOT_FOUND;
+}
+
+/**
+ * @brief Get the number of node's neighbors
+ * 16Nov18
+ * 
+ * @return int - Number of node's neighbors
+ */
+
+int
+FlySafeNeighborTable::GetNNeighbors (void)
+{
+  NS_LOG_FUNCTION (this);
+  return (int) m_neighbors.ip.size ();
+}
+
+
+/**
+ * @brief Clean the neighbor list
+ * @date Mar 10, 2023
+ */
+
+void
+FlySafeNeighborTable::ClearNeighborList ()
+{
+  NS_LOG_FUNCTION (this);
+  m_neighborsVersion++;
+  ResizeNeighbors (0);
+  m_neighborIndex.Clear ();
+  m_expiryWheel.Clear ();
+  m_expiryEvent.Cancel ();
+}
+
+/**
+ * @brief Age the NL and evict the ordinary neighbors that expired
+ * @date Jan 26, 2024
+ *
+ * Decreases by one the quality of every neighbor with quality above 0 and
+ * removes, in a single erase-remove pass, the ordinary neighbors (state 0)
+ * whose quality reached 0. Suspicious nodes are kept. The remaining
+ * neighbors keep their relative order.
+ *
+ * @return std::vector<Neighbor> - Evicted neighbors, as they were when removed
+ */
+
+std::vector<struct FlySafeNeighborTable::Neighbor>
+FlySafeNeighborTable::AgeAndEvictNeighbors ()
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<struct FlySafeNeighborTable::Neighbor> evicted;
+  uint32_t n = m_neighbors.ip.size ();
+
+  m_neighborsVersion++;
+  NeighborScan::DecrementNonZero (m_neighbors.quality.data (), n);
+
+  std::vector<uint32_t> expired;
+  NeighborScan::CollectBothZero (m_neighbors.quality.data (), m_neighbors.state.data (), n, expired);
+  if (expired.empty ())
+    {
+      return evicted; // Nothing to compact
+    }
+
+  evicted.reserve (expired.size ());
+  std::vector<uint32_t>::const_iterator nextExpired = expired.begin ();
+  uint32_t write = expired.front ();
+  for (uint32_t read = write; read < n; read++)
+    {
+      if (nextExpired != expired.end () && *nextExpired == read)
+        {
+          evicted.push_back (LoadNeighbor (read));
+          m_neighborIndex.Erase (m_neighbors.ip[read]);
+          nextExpired++;
+          continue;
+        }
+      MoveNeighbor (read, write);
+      m_neighborIndex.Insert (m_neighbors.ip[write], write);
+      write++;
+    }
+  ResizeNeighbors (write);
+  return evicted;
+}
+
+/**
+ * @brief Get the neighbors registered closer than a given distance
+ * @date Jan 22, 2024
+ *
+ * @param distance - Distance limit in meters (exclusive)
+ * @return std::vector<Neighbor> - Neighbors closer than distance, in NL order
+ */
+
+std::vector<struct FlySafeNeighborTable::Neighbor>
+FlySafeNeighborTable::GetNeighborsCloserThan (double distance) const
+{
+  NS_LOG_FUNCTION (this << distance);
+  std::vector<uint32_t> slots;
+  NeighborScan::CollectBelow (m_neighbors.distance.data (), m_neighbors.distance.size (),
+                              distance, slots);
+  std::vector<struct FlySafeNeighborTable::Neighbor> closer;
+  closer.reserve (slots.size ());
+  for (std::vector<uint32_t>::const_iterator i = slots.begin (); i != slots.end (); i++)
+    {
+      closer.push_back (LoadNeighbor (*i));
+    }
+  return closer;
+}
+
+/**
+ * @brief Order neighbor entries by IPv4 address, freshest information first
+ * @date Jan 24, 2024
+ * @date Feb 21, 2024 - Freshest first among entries of the same address
+ */
+
+static bool
+NeighborIpLess (const struct FlySafeNeighborTable::Neighbor &a, const struct FlySafeNeighborTable::Neighbor &b)
+{
+  if (a.ip == b.ip)
+    {
+      return a.infoTime > b.infoTime;
+    }
+  return a.ip < b.ip;
+}
+
+/**
+ * @brief Merge a NL received from a neighbor into this node NL
+ * @date Jan 24, 2024
+ * @date Feb 21, 2024 - Keep the freshest information of each node
+ * @date Feb 25, 2024 - A single eviction ranking when the NL is full
+ * @date Feb 25, 2024 - Relayed entries expire from their information time
+ *
+ * For every received entry, except this node itself and blocked nodes:
+ * - known neighbor heard by this node after the sender: keep the lowest
+ *   hop only, a stale relay never overwrites fresher data
+ * - known neighbor that moved: update position, distance and attitude,
+ *   take the received information time, set quality 1 and keep the
+ *   lowest hop (received hop + 1 or registered)
+ * - known neighbor that did not move: take the received information
+ *   time and keep the lowest hop
+ * - unknown node: register it with quality 1, received hop + 1 and the
+ *   received information time, expiring NeighborMaxAge after that time
+ *
+ * With neighbor expiry enabled, entries not heard for NeighborMaxAge are
+ * dropped, so two nodes can not keep relaying a departed node forever.
+ *
+ * Entries are sorted by address once to drop duplicates, keeping the
+ * freshest one, so the whole merge costs O(n log n). Unknown nodes that
+ * do not fit in a full NL are ranked with it once, at the end.
+ *
+ * @param entries - Received NL (ip, position, hop, state and infoTime are used)
+ * @param selfPosition - This node current position
+ * @param selfIp - This node IPv4 address
+ * @return uint32_t - Number of entries merged into the NL
+ */
+
+uint32_t
+FlySafeNeighborTable::MergeNeighborList (std::vector<struct FlySafeNeighborTable::Neighbor> entries, Vector selfPosition, Ipv4Address selfIp)
+{
+  NS_LOG_FUNCTION (this << entries.size ());
+  std::sort (entries.begin (), entries.end (), &NeighborIpLess);
+
+  m_neighborsVersion++;
+  double now = Simulator::Now ().GetSeconds ();
+  uint32_t merged = 0;
+  std::vector<struct FlySafeNeighborTable::Neighbor> overflow; // Unknown nodes beyond the NL capacity
+  for (std::vector<struct FlySafeNeighborTable::Neighbor>::const_iterator n = entries.begin (); n != entries.end (); n++)
+    {
+      if (n != entries.begin () && (n - 1)->ip == n->ip)
+        {
+          continue; // Older duplicated entry in the received NL
+        }
+      if (n->ip == selfIp || IsABlockedNode (n->ip))
+        {
+          continue; // Avoid register in NL the node itself or a blocked node
+        }
+
+      double infoTime = std::min (n->infoTime, now); // Never newer than this node clock
+      if (IsNeighborExpiryEnabled () && Seconds (infoTime) + m_neighborMaxAge <= Simulator::Now ())
+        {
+          continue; // Not heard for NeighborMaxAge, already expired here - Feb 25, 24
+        }
+      double distance = std::ceil (CalculateDistance (selfPosition, n->position) * 100.0) / 100.0; // 2 decimal cases
+      int hop = std::min (n->hop + 1, 255); // Saturate, a wrapped hop 0 would look closer than hop 1
+      uint32_t slot = m_neighborIndex.Find (n->ip);
+
+      if (slot == Ipv4AddressIndex::NOT_FOUND)
+        {
+          // Neighbors from neighbors are registered with quality 1 to
+          // reduce their permanence in the NL
+          struct FlySafeNeighborTable::Neighbor candidate = *n;
+          candidate.distance = distance;
+          candidate.attitude = 0;
+          candidate.quality = 1;
+          candidate.hop = hop;
+          candidate.state = 0;
+          candidate.infoTime = infoTime;
+          if (m_maxNeighbors != 0 && m_neighbors.ip.size () >= m_maxNeighbors)
+            {
+              overflow.push_back (candidate);
+              continue; // Ranked with the NL after the updates
+            }
+          InsertNeighbor (candidate);
+        }
+      else if (infoTime <= m_neighbors.infoTime[slot]) // Stale relay
+        {
+          m_neighbors.hop[slot] = std::min (hop, (int) m_neighbors.hop[slot]);
+          continue;
+        }
+      else if (m_neighbors.x[slot] != n->position.x || m_neighbors.y[slot] != n->position.y
+               || m_neighbors.z[slot] != n->position.z)
+        {
+          double oldDistance = m_neighbors.distance[slot];
+          SetNeighborPosition (slot, n->position);
+          m_neighbors.attitude[slot] = (distance == oldDistance) ? 0 : (distance < oldDistance) ? 1 : 2;
+          m_neighbors.distance[slot] = distance;
+          m_neighbors.quality[slot] = 1;
+          m_neighbors.hop[slot] = std::min (hop, (int) m_neighbors.hop[slot]);
+          m_neighbors.infoTime[slot] = infoTime;
+        }
+      else // Neighbor node is stopped
+        {
+          m_neighbors.hop[slot] = std::min (hop, (int) m_neighbors.hop[slot]);
+          m_neighbors.infoTime[slot] = infoTime;
+        }
+      merged++;
+    }
+  if (!overflow.empty ())
+    {
+      merged += AdmitNeighbors (overflow);
+    }
+  return merged;
+}
+
+/**
+ * @brief Get the NL version
+ * @date Feb 1, 2024
+ *
+ * The version changes whenever the NL may have changed.
+ *
+ * @return uint64_t - NL version
+ */
+
+uint64_t
+FlySafeNeighborTable::GetNeighborsVersion (void) const
+{
+  return m_neighborsVersion;
+}
+
+/**
+ * @brief Get an immutable copy of the NL
+ * @date Feb 1, 2024
+ *
+ * The copy is built only when the NL changed since the last call,
+ * otherwise the previous snapshot is returned.
+ *
+ * @return Ptr<const NeighborSnapshot> - Neighbors, in NL order
+ */
+
+Ptr<const NeighborSnapshot>
+FlySafeNeighborTable::GetNeighborSnapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_neighborSnapshot == 0 || m_neighborSnapshot->GetVersion () != m_neighborsVersion)
+    {
+      uint32_t n = m_neighbors.ip.size ();
+      std::vector<struct FlySafeNeighborTable::Neighbor> neighbors;
+      neighbors.reserve (n);
+      for (uint32_t slot = 0; slot < n; slot++)
+        {
+          neighbors.push_back (LoadNeighbor (slot));
+        }
+      m_neighborSnapshot = Create<NeighborSnapshot> (m_neighborsVersion, neighbors);
+    }
+  return m_neighborSnapshot;
+}
+
+/**
+ * @brief Gather the columns of one NL slot into a neighbor entry
+ * @date Jan 22, 2024
+ *
+ * @param slot - Position of the neighbor in the NL columns
+ * @return Neighbor - Neighbor node information
+ */
+
+struct FlySafeNeighborTable::Neighbor
+FlySafeNeighborTable::LoadNeighbor (uint32_t slot) const
+{
+  struct FlySafeNeighborTable::Neighbor neighbor;
+  neighbor.ip = m_neighbors.ip[slot];
+  neighbor.position = Vector (m_neighbors.x[slot], m_neighbors.y[slot], m_neighbors.z[slot]);
+  neighbor.distance = m_neighbors.distance[slot];
+  neighbor.attitude = m_neighbors.attitude[slot];
+  neighbor.quality = m_neighbors.quality[slot];
+  neighbor.hop = m_neighbors.hop[slot];
+  neighbor.state = m_neighbors.state[slot];
+  neighbor.infoTime = m_neighbors.infoTime[slot];
+  return neighbor;
+}
+
+/**
+ * @brief Scatter a neighbor entry into one NL slot
+ * @date Jan 22, 2024
+ *
+ * @param slot - Position of the neighbor in the NL columns
+ * @param neighbor - Neighbor node information
+ */
+
+void
+FlySafeNeighborTable::StoreNeighbor (uint32_t slot, const struct FlySafeNeighborTable::Neighbor &neighbor)
+{
+  m_neighbors.ip[slot] = neighbor.ip;
+  m_neighbors.x[slot] = neighbor.position.x;
+  m_neighbors.y[slot] = neighbor.position.y;
+  m_neighbors.z[slot] = neighbor.position.z;
+  m_neighbors.distance[slot] = neighbor.distance;
+  m_neighbors.attitude[slot] = neighbor.attitude;
+  m_neighbors.quality[slot] = neighbor.quality;
+  m_neighbors.hop[slot] = neighbor.hop;
+  m_neighbors.state[slot] = neighbor.state;
+  m_neighbors.infoTime[slot] = neighbor.infoTime;
+}
+
+/**
+ * @brief Copy one NL slot into another slot, including its expiry
+ * @date Feb 5, 2024
+ *
+ * @param from - Source slot
+ * @param to - Destination slot
+ */
+
+void
+FlySafeNeighborTable::MoveNeighbor (uint32_t from, uint32_t to)
+{
+  StoreNeighbor (to, LoadNeighbor (from));
+  m_neighbors.expiry[to] = m_neighbors.expiry[from];
+}
+
+/**
+ * @brief Change the position of a NL slot
+ * @date Feb 7, 2024
+ *
+ * @param slot - Position of the neighbor in the NL columns
+ * @param position - New neighbor position
+ */
+
+void
+FlySafeNeighborTable::SetNeighborPosition (uint32_t slot, Vector position)
+{
+  m_neighbors.x[slot] = position.x;
+  m_neighbors.y[slot] = position.y;
+  m_neighbors.z[slot] = position.z;
+}
+
+/**
+ * @brief Keep only the first n entries of the NL columns
+ * @date Jan 26, 2024
+ *
+ * The neighbor index is not touched, callers update it.
+ *
+ * @param n - New number of entries
+ */
+
+void
+FlySafeNeighborTable::ResizeNeighbors (uint32_t n)
+{
+  m_neighbors.ip.resize (n);
+  m_neighbors.x.resize (n);
+  m_neighbors.y.resize (n);
+  m_neighbors.z.resize (n);
+  m_neighbors.distance.resize (n);
+  m_neighbors.attitude.resize (n);
+  m_neighbors.quality.resize (n);
+  m_neighbors.hop.resize (n);
+  m_neighbors.state.resize (n);
+  m_neighbors.infoTime.resize (n);
+  m_neighbors.expiry.resize (n);
+}
+
+/**
+ * @brief Check whether neighbors expire by age
+ * @date Feb 5, 2024
+ *
+ * @return true - Neighbors not heard for NeighborMaxAge are removed
+ * @return false - Neighbors are only removed by quality aging
+ */
+
+bool
+FlySafeNeighborTable::IsNeighborExpiryEnabled (void) const
+{
+  return !m_neighborMaxAge.IsZero ();
+}
+
+/**
+ * @brief Keep the NL capacity within a limit
+ * @date Feb 25, 2024
+ *
+ * Lowers MaxNeighbors to maxNeighbors when it is unlimited or larger, as
+ * when the NL must fit in a single message.
+ *
+ * @param maxNeighbors - Most entries the NL may hold
+ */
+
+void
+FlySafeNeighborTable::LimitNeighbors (uint32_t maxNeighbors)
+{
+  NS_LOG_FUNCTION (this << maxNeighbors);
+  if (m_maxNeighbors == 0 || m_maxNeighbors > maxNeighbors)
+    {
+      NS_LOG_WARN ("MaxNeighbors " << m_maxNeighbors << " lowered to " << maxNeighbors);
+      m_maxNeighbors = maxNeighbors;
+    }
+}
+
+/**
+ * @brief Convert a time to an expiry wheel tick, rounding up
+ * @date Feb 5, 2024
+ *
+ * @param time - Simulation time
+ * @return uint64_t - First tick not before time
+ */
+
+uint64_t
+FlySafeNeighborTable::GetExpiryTick (Time time) const
+{
+  int64_t resolution = m_neighborExpiryResolution.GetTimeStep ();
+  return (time.GetTimeStep () + resolution - 1) / resolution;
+}
+
+/**
+ * @brief Get the expiry wheel tick reached by the simulation, rounding down
+ * @date Feb 5, 2024
+ *
+ * @return uint64_t - Last tick not after now
+ */
+
+uint64_t
+FlySafeNeighborTable::GetCurrentExpiryTick (void) const
+{
+  return Simulator::Now ().GetTimeStep () / m_neighborExpiryResolution.GetTimeStep ();
+}
+
+/**
+ * @brief Schedule the expiry of a neighbor
+ * @date Feb 5, 2024
+ * @date Feb 25, 2024 - Expiry event at the next due tick
+ *
+ * The wheel is only advanced at the ticks holding entries, so a node has
+ * no expiry event while none of its neighbors is due.
+ *
+ * @param slot - Position of the neighbor in the NL columns
+ * @param deadline - Expiry tick
+ */
+
+void
+FlySafeNeighborTable::ScheduleNeighborExpiry (uint32_t slot, uint64_t deadline)
+{
+  if (m_expiryWheel.GetSize () == 0)
+    {
+      std::vector<NeighborTimerWheel::Entry> none;
+      m_expiryWheel.Advance (GetCurrentExpiryTick (), none); // Jump over the idle period
+    }
+  deadline = std::max (deadline, m_expiryWheel.GetNow () + 1);
+  m_neighbors.expiry[slot] = deadline;
+  m_expiryWheel.Schedule (m_neighbors.ip[slot], deadline);
+  ScheduleExpiryEvent ();
+}
+
+/**
+ * @brief Schedule the expiry event at the next wheel tick holding entries
+ * @date Feb 25, 2024
+ *
+ * An event already due by then is kept.
+ */
+
+void
+FlySafeNeighborTable::ScheduleExpiryEvent (void)
+{
+  if (m_expiryWheel.GetSize () == 0)
+    {
+      return;
+    }
+  Time next = TimeStep (m_expiryWheel.GetNextTick () * m_neighborExpiryResolution.GetTimeStep ());
+  if (m_expiryEvent.IsRunning () && m_expiryEvent.GetTs () <= (uint64_t) next.GetTimeStep ())
+    {
+      return;
+    }
+  m_expiryEvent.Cancel ();
+  m_expiryEvent = Simulator::Schedule (std::max (next - Simulator::Now (), Seconds (0)),
+                                       &FlySafeNeighborTable::ExpireNeighbors, this);
+}
+
+/**
+ * @brief Remove from the NL the ordinary neighbors not heard for NeighborMaxAge
+ * @date Feb 5, 2024
+ * @date Feb 25, 2024 - Run at the wheel ticks holding entries only
+ *
+ * Neighbors heard since their entry was scheduled are scheduled again at
+ * their new deadline. Suspicious neighbors are kept and checked again
+ * one NeighborMaxAge later.
+ */
+
+void
+FlySafeNeighborTable::ExpireNeighbors (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!IsNeighborExpiryEnabled ())
+    {
+      m_expiryWheel.Clear ();
+      return;
+    }
+
+  std::vector<NeighborTimerWheel::Entry> expired;
+  m_expiryWheel.Advance (GetCurrentExpiryTick (), expired);
+  for (std::vector<NeighborTimerWheel::Entry>::const_iterator e = expired.begin (); e != expired.end (); e++)
+    {
+      uint32_t slot = m_neighborIndex.Find (e->ip);
+      if (slot == Ipv4AddressIndex::NOT_FOUND || m_neighbors.expiry[slot] != e->deadline)
+        {
+          continue; // Removed, or registered again with its own entry
+        }
+      uint64_t deadline = GetExpiryTick (Seconds (m_neighbors.infoTime[slot]) + m_neighborMaxAge);
+      if (deadline > e->deadline)
+        {
+          ScheduleNeighborExpiry (slot, deadline); // Heard in the meantime
+        }
+      else if (m_neighbors.state[slot] != 0)
+        {
+          ScheduleNeighborExpiry (slot, GetExpiryTick (Simulator::Now () + m_neighborMaxAge));
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Neighbor " << e->ip << " expired");
+          UnregisterNeighbor (e->ip);
+        }
+    }
+
+  ScheduleExpiryEvent ();
+}
+
+/**
+ * @brief Get nodes position (x,y,z)
+ * 26Sep2022
+ * 
+ * @return Vector - Nodes position (x,y,z)
+ */
+
+Vector
+FlySafeNeighborTable::GetPosition()
+{
+  NS_LOG_FUNCTION (this);
+  return(m_position);
+}
+
+
+/**
+ * @brief Check whether the node is moving
+ * 26Sep2022
+ * 
+ * @param position - Vector with actual node position
+ * @return true - Node is moving
+ * @return false - Node is stopped
+ */
+
+bool
+FlySafeNeighborTable::IsMoving (Vector position)
+{
+  NS_LOG_FUNCTION (this);
+  return (m_position.x != position.x) || (m_position.y != position.y) || (m_position.z != position.z);
+}
+
+
+/**
+ * @brief Set nodes position (x,y,z)
+ * 26Sep2022
+ * 
+ * @param position - Vector with coordinates
+ */
+
+void
+FlySafeNeighborTable::SetPosition(Vector position)
+{
+  NS_LOG_FUNCTION (this);
+  m_position = position;
+}
+
+/**
+ * @brief Get nodes state
+ * @date Oct 23, 2023
+ * 
+ * @return u_int8_t - node state (0 ordinary, 1 malicious)
+ */
+
+u_int8_t
+FlySafeNeighborTable::GetState()
+{
+  NS_LOG_FUNCTION (this);
+  return(m_state);
+}
+
+
+/**
+ * @brief Set node state (0 ordinary, 1 malicious)
+ * @date Oct 23, 2023
+ * 
+ * @param state - node state (0 ordinary, 1 malicious)
+ */
+void
+FlySafeNeighborTable::SetState(u_int8_t state)
+{
+  NS_LOG_FUNCTION (this);
+  m_state = state;
+}
+
+// ---------------------------------------------------------------------
+// Methods for control malicious neighbor nodes
+// (Suspect or blocked)
+// ---------------------------------------------------------------------
+
+/**
+ * @brief Register a neighbor node in the malicious list
+ * @date Oct 23, 2023
+ *
+ * Registering a node that is already in the list restarts its entry.
+ * 
+ * @param ip IPv4 from malicious node 
+ * @param notifyIP IPv4 from notifier node
+ */
+void
+FlySafeNeighborTable::RegisterMaliciousNode (Ipv4Address ip, Ipv4Address notifyIP)
+{
+  NS_LOG_FUNCTION (this);
+  struct FlySafeNeighborTable::MaliciousNode maliciousNeighbor;
+
+  maliciousNeighbor.ip = ip;
+  maliciousNeighbor.state = 0;
+  maliciousNeighbor.recurrence = 1;
+  maliciousNeighbor.notifyIP.push_back(notifyIP);
+
+  uint32_t slot = m_maliciousIndex.Find (ip);
+  if (slot != Ipv4AddressIndex::NOT_FOUND)
+    {
+      m_MaliciousNodeList[slot] = maliciousNeighbor;
+      return;
+    }
+  m_maliciousIndex.Insert (ip, m_MaliciousNodeList.size ());
+  m_MaliciousNodeList.push_back (maliciousNeighbor);
+  m_maliciousIps.push_back (ip);
+}
+
+/**
+ * @brief Remove a neighbor node from the malicious list
+ * @date Oct 23, 2023
+ *
+ * The last node of the list takes the place of the removed one.
+ * 
+ * @param ip IPv4 from malicious node 
+ */
+void
+FlySafeNeighborTable::UnregisterMaliciousNode (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = m_maliciousIndex.Find (ip);
+  if (slot == Ipv4AddressIndex::NOT_FOUND)
+    {
+      return;
+    }
+  uint32_t last = m_MaliciousNodeList.size () - 1;
+  if (slot != last)
+    {
+      std::swap (m_MaliciousNodeList[slot], m_MaliciousNodeList[last]);
+      m_maliciousIps[slot] = m_maliciousIps[last];
+      m_maliciousIndex.Insert (m_MaliciousNodeList[slot].ip, slot);
+    }
+  m_MaliciousNodeList.pop_back ();
+  m_maliciousIps.pop_back ();
+  m_maliciousIndex.Erase (ip);
+}
+
+/**
+ * @brief Get a malicious node recurrence
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Malicious node IPv4 address
+ * @return uint8_t - Neighbor node recurrence, 0 if the node is not in the list
+ */
+uint8_t
+FlySafeNeighborTable::GetMaliciousNodeRecurrence (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  const struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  return malicious ? malicious->recurrence : 0;
+}
+
+/**
+ * @brief Increase a malicious node recurrence
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Malicious node IPv4 address
+ * @param notifyIP IPv4 address from notifier node
+ */
+void
+FlySafeNeighborTable::IncreaseMaliciousNodeRecurrence (Ipv4Address ip, Ipv4Address notifyIP)
+{
+  NS_LOG_FUNCTION (this);
+  struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  if (malicious)
+    {
+      malicious->recurrence += 1;
+      malicious->notifyIP.push_back (notifyIP);
+    }
+}
+
+
+/**
+ * @brief Decrease a malicious node recurrence
+ * @date Nov 2, 2023
+ *
+ * Only a notifier that raised the recurrence can decrease it. One of its
+ * notifications is dropped, the last notifier taking its place.
+ * 
+ * @param ip - Malicious node IPv4 address
+ * @param notifyIP IPv4 address from notifier node
+ */
+void
+FlySafeNeighborTable::DecreaseMaliciousNodeRecurrence (Ipv4Address ip, Ipv4Address notifyIP)
+{
+  NS_LOG_FUNCTION (this);
+  struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  if (!malicious)
+    {
+      return;
+    }
+  std::vector<Ipv4Address> &notifiers = malicious->notifyIP;
+  std::vector<Ipv4Address>::iterator n = std::find (notifiers.begin (), notifiers.end (), notifyIP);
+  if (n != notifiers.end ())
+    {
+      malicious->recurrence -= 1;
+      *n = notifiers.back ();
+      notifiers.pop_back ();
+    }
+}
+
+/**
+ * @brief Get a malicious node state (0 suspect, 1 Blocked)
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Malicious node IPv4 address
+ * @return uint8_t - 0 (suspect or not in the list)
+ * @return uint8_t - 1 (blocked)
+ */
+uint8_t
+FlySafeNeighborTable::GetMaliciousNodeState (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  const struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  return malicious ? malicious->state : 0;
+}
+
+/**
+ * @brief Set a malicious node state (0 suspect, 1 Blocked)
+ * @date Oct 23, 2023
+ * 
+ * @param ip - Malicious node IPv4 address
+ * @param state - Malicious node state (0 suspect, 1 Blocked)
+ */
+void
+FlySafeNeighborTable::SetMaliciousNodeState (Ipv4Address ip, uint8_t state)
+{
+  NS_LOG_FUNCTION (this);
+  struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  if (malicious)
+    {
+      malicious->state = state;
+    }
+}
+
+/**
+ * @brief Verify if there are known malicious nodes 
+ * @date Oct 23, 2023
+ * 
+ * @return true - Node knows malicious nodes
+ * @return false - Node doesn't know malicious nodes
+ */
+bool
+FlySafeNeighborTable::IsThereAnyMaliciousNode ()
+{
+  NS_LOG_FUNCTION (this);
+  return !m_MaliciousNodeList.empty ();
+}
+
+/**
+ * @brief Get a IPv4 list of known malicious nodes 
+ * @date Oct 23, 2023
+ * 
+ * @return vector - IPv4 list with known malicious nodes
+ */
+std::vector<Ipv4Address>
+FlySafeNeighborTable::GetMaliciousNodeIpList ()
+{
+  NS_LOG_FUNCTION (this);
+  return m_maliciousIps;
+}
+
+
+/**
+ * @brief Get a malicious nodes notifiers IP address 
+ * 
+ * @date Nov 23, 2023
+ * 
+ * @param maliciousNode Malicious node IPv4
+ * @return std::vector<Ipv4Address> - Vector with malicious nodes notifiers IP address 
+ */
+std::vector<Ipv4Address>
+FlySafeNeighborTable::GetMaliciousNodesIPNotifiers (Ipv4Address maliciousNode)
+{
+  NS_LOG_FUNCTION (this);
+  return GetMaliciousNodeNotifiers (maliciousNode).ToVector ();
+}
+
+/**
+ * @brief Get a view of the known malicious nodes IP addresses
+ * @date Jan 30, 2024
+ *
+ * Nothing is copied. The view is invalidated when a malicious node is
+ * registered or removed.
+ *
+ * @return Ipv4AddressRange - Known malicious nodes IP addresses
+ */
+Ipv4AddressRange
+FlySafeNeighborTable::GetMaliciousNodeIps () const
+{
+  return Ipv4AddressRange (m_maliciousIps);
+}
+
+/**
+ * @brief Get a view of a malicious node notifiers IP address
+ * @date Jan 30, 2024
+ *
+ * Nothing is copied. The view is invalidated when the malicious list
+ * is modified.
+ *
+ * @param maliciousNode Malicious node IPv4
+ * @return Ipv4AddressRange - Notifiers IP address, empty if the node is not in the list
+ */
+Ipv4AddressRange
+FlySafeNeighborTable::GetMaliciousNodeNotifiers (Ipv4Address maliciousNode) const
+{
+  uint32_t slot = m_maliciousIndex.Find (maliciousNode);
+  if (slot == Ipv4AddressIndex::NOT_FOUND)
+    {
+      return Ipv4AddressRange ();
+    }
+  return Ipv4AddressRange (m_MaliciousNodeList[slot].notifyIP);
+}
+
+
+
+/**
+ * @brief Verify wether a node is already known as malicious 
+ * @date Oct 23, 2023
+ * 
+ * @param ip - node IPv4 address 
+ * @return false - Node is not known as malicious
+ * @return true - Node is already known as malicious
+ */
+bool
+FlySafeNeighborTable::IsAMaliciousNode (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  return m_maliciousIndex.Find (ip) != Ipv4AddressIndex::NOT_FOUND;
+}
+
+
+/**
+ * @brief Verify wether a malicious node is already blocked 
+ * @date Oct 23, 2023
+ * 
+ * @param ip - node IPv4 address 
+ * @return false - Suspect
+ * @return true - Blocked
+ */
+bool
+FlySafeNeighborTable::IsABlockedNode (Ipv4Address ip)
+{
+  NS_LOG_FUNCTION (this);
+  const struct FlySafeNeighborTable::MaliciousNode *malicious = LookupMaliciousNode (ip);
+  return malicious && malicious->state == 1;
+}
+
+/**
+ * @brief Get the amount of known malicious nodes in the list
+ * @date Oct 23, 2023
+ * 
+ * @return uint32_t - Number of malicious nodes
+ */
+uint32_t
+FlySafeNeighborTable::GetNMaliciousNodes (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_MaliciousNodeList.size ();
+}
+
+/**
+ * @brief Clear malicious nodes list
+ * @date Oct 23, 2023
+ */
+void
+FlySafeNeighborTable::ClearMaliciousNodeList ()
+{
+  NS_LOG_FUNCTION (this);
+  m_MaliciousNodeList.clear();
+  m_maliciousIps.clear ();
+  m_maliciousIndex.Clear ();
+}
+
+/**
+ * @brief Find a node in the malicious list
+ * @date Jan 29, 2024
+ *
+ * @param ip - node IPv4 address
+ * @return MaliciousNode* - The malicious list entry, 0 if ip is not in the list
+ */
+struct FlySafeNeighborTable::MaliciousNode *
+FlySafeNeighborTable::LookupMaliciousNode (Ipv4Address ip)
+{
+  uint32_t slot = m_maliciousIndex.Find (ip);
+  return slot == Ipv4AddressIndex::NOT_FOUND ? 0 : &m_MaliciousNodeList[slot];
+}
+
+
+} // namespace ns3
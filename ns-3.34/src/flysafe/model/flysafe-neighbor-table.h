@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef FLYSAFE_NEIGHBOR_TABLE_H
+#define FLYSAFE_NEIGHBOR_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-address-index.h"
+#include "ns3/ipv4-address-range.h"
+#include "ns3/neighbor-timer-wheel.h"
+
+namespace ns3 {
+
+class Node;
+class NeighborSnapshot;
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief FlySafe state of a node: neighbor list (NL), suspicious list (SL),
+ * position and state (0 ordinary, 1 malicious).
+ *
+ * The table is aggregated to the node, so ns3::Node stays as in a stock
+ * ns-3 build. FlySafeOnOff and FlySafePacketSink keep a pointer to the
+ * table of their node.
+ */
+class FlySafeNeighborTable : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  FlySafeNeighborTable ();
+  virtual ~FlySafeNeighborTable ();
+
+  /**
+   * \brief Get the table of a node, aggregating a new one if needed
+   * \param node the node
+   * \returns the table aggregated to node
+   */
+  static Ptr<FlySafeNeighborTable> Install (Ptr<Node> node);
+
+  /**
+   * \brief Neighbor entry.
+   * This structure is used to store Neighbors' node.
+   */
+
+  struct Neighbor
+  {
+    Ipv4Address ip;   //!< the neighbor IP address
+    Vector position;  //!< x,y,z vector position
+    double distance;  //!< neighbor distance
+    uint8_t attitude; //!< inbound, stable, outbound
+    uint8_t quality;  //!< 0 - 2 controls neighbor absence in the list
+    uint8_t hop;      //!< hop = 1 means neibhor in range, 
+    uint8_t state;    //!< 0 ordinary, 1 malicious
+    double infoTime;  //!< last time the neighbor was heard (s)
+  }; 
+
+
+  bool RegisterNeighbor (Ipv4Address ip, Vector position, double distance, u_int8_t attitude, u_int8_t quality, uint8_t hop, uint8_t state); //, double time);
+  void UnregisterNeighbor (Ipv4Address ip);
+  void UpdateNeighbor (Ipv4Address ip, Vector position, double distance, uint8_t attitude, uint8_t quality, uint8_t hop); //, uint8_t state); //, double time);
+  Vector GetNeighborPosition (Ipv4Address ip);
+  double GetNeighborDistance (Ipv4Address ip);
+  uint8_t GetNeighborAttitude (Ipv4Address ip);
+  void SetNeighborAttitude (Ipv4Address ip, uint8_t attitude);
+  uint8_t GetNeighborQuality (Ipv4Address ip);
+  void SetNeighborQuality (Ipv4Address ip, uint8_t quality);
+  uint8_t GetNeighborHop (Ipv4Address ip);
+  void SetNeighborHop (Ipv4Address ip, uint8_t hop);
+  uint8_t GetNeighborNodeState (Ipv4Address ip);
+  void SetNeighborNodeState (Ipv4Address ip, uint8_t state);
+  bool FindNeighbor (Ipv4Address ip, struct Neighbor &neighbor) const;
+  struct Neighbor GetNeighbor (uint32_t index) const;
+  double GetNeighborInfoTime (Ipv4Address ip);
+  void SetNeighborInfoTime (Ipv4Address ip, double time);
+  bool IsNeighborExpiryEnabled (void) const;
+  void LimitNeighbors (uint32_t maxNeighbors);
+
+  bool IsThereAnyNeighbor ();
+  bool IsThereAnyNeighbor (uint8_t hop);
+  std::vector<Ipv4Address> GetNeighborIpList ();
+  Ipv4AddressRange GetNeighborIps () const;
+  void TurnOffLiveNeighbors ();
+  bool IsAlreadyNeighbor (Ipv4Address ip);
+  int GetNNeighbors ();
+  void ClearNeighborList ();
+  std::vector<struct Neighbor> AgeAndEvictNeighbors ();
+  std::vector<struct Neighbor> GetNeighborsCloserThan (double distance) const;
+  uint32_t MergeNeighborList (std::vector<struct Neighbor> entries, Vector selfPosition, Ipv4Address selfIp);
+  uint64_t GetNeighborsVersion (void) const;
+  Ptr<const NeighborSnapshot> GetNeighborSnapshot (void);
+  Vector GetPosition (void);
+  bool IsAttending (void);
+  bool IsMoving (Vector position);
+  void SetPosition (Vector position);
+  u_int8_t GetState();
+  void SetState(u_int8_t state);
+
+  // ---------------------------------------------------------------------
+  // Methods for control malicious neighbor nodes
+  // ---------------------------------------------------------------------
+  void RegisterMaliciousNode (Ipv4Address ip, Ipv4Address notifyIP);
+  void UnregisterMaliciousNode (Ipv4Address ip);
+  uint8_t GetMaliciousNodeRecurrence (Ipv4Address ip);
+  void IncreaseMaliciousNodeRecurrence (Ipv4Address ip, Ipv4Address notifyIP);
+  void DecreaseMaliciousNodeRecurrence (Ipv4Address ip, Ipv4Address notifyIP);
+  uint8_t GetMaliciousNodeState (Ipv4Address ip);
+  void SetMaliciousNodeState (Ipv4Address ip, uint8_t state);
+
+  bool IsThereAnyMaliciousNode ();
+  std::vector<Ipv4Address> GetMaliciousNodeIpList ();
+  std::vector<Ipv4Address> GetMaliciousNodesIPNotifiers (Ipv4Address maliciousNode);
+  Ipv4AddressRange GetMaliciousNodeIps () const;
+  Ipv4AddressRange GetMaliciousNodeNotifiers (Ipv4Address maliciousNode) const;
+  bool IsAMaliciousNode (Ipv4Address ip);
+  bool IsABlockedNode (Ipv4Address ip);
+  uint32_t GetNMaliciousNodes ();
+  void ClearMaliciousNodeList ();
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  struct MaliciousNode
+  {
+    Ipv4Address ip;     //!< the neighbor IP address
+    uint8_t state;      //!< 0 suspicious, 1 blocked
+    uint8_t recurrence; //!< 1 - 3
+    std::vector<Ipv4Address> notifyIP; //!< one notifier per recurrence, unordered
+  }; 
+
+  /**
+   * \brief Neighbor list stored as a structure of arrays.
+   * Entry i of the NL is at position i of every column, so scans over
+   * one field (hop, quality, state, distance) read only that field.
+   */
+  struct NeighborColumns
+  {
+    std::vector<Ipv4Address> ip;    //!< neighbor IP addresses
+    std::vector<double> x;          //!< x coordinates
+    std::vector<double> y;          //!< y coordinates
+    std::vector<double> z;          //!< z coordinates
+    std::vector<double> distance;   //!< neighbor distances
+    std::vector<uint8_t> attitude;  //!< inbound, stable, outbound
+    std::vector<uint8_t> quality;   //!< 0 - 3 controls neighbor absence in the list
+    std::vector<uint8_t> hop;       //!< hop = 1 means neighbor in range
+    std::vector<uint8_t> state;     //!< 0 ordinary, 1 malicious
+    std::vector<double> infoTime;   //!< last time heard (s)
+    std::vector<uint64_t> expiry;   //!< deadline of the valid expiry wheel entry
+  };
+
+  typedef std::vector<struct FlySafeNeighborTable::MaliciousNode> MaliciousNodeHandlerList;   //!< Malicious nodes list struct
+
+  /**
+   * \brief Gather the columns of one NL slot into an entry
+   * \param slot the position of the neighbor in the columns
+   * \returns the neighbor entry
+   */
+  struct Neighbor LoadNeighbor (uint32_t slot) const;
+
+  /**
+   * \brief Scatter an entry into the columns of one NL slot
+   * \param slot the position of the neighbor in the columns
+   * \param neighbor the neighbor entry
+   */
+  void StoreNeighbor (uint32_t slot, const struct Neighbor &neighbor);
+
+  /**
+   * \brief Copy every column of one NL slot into another slot
+   * \param from the source slot
+   * \param to the destination slot
+   */
+  void MoveNeighbor (uint32_t from, uint32_t to);
+
+  /**
+   * \brief Register one neighbor entry, expiring NeighborMaxAge after its information time
+   * \param neighbor the neighbor entry
+   * \returns false if the NL is full of entries better than this one
+   */
+  bool InsertNeighbor (const struct Neighbor &neighbor);
+
+  /**
+   * \brief Change the position of one NL slot
+   * \param slot the position of the neighbor in the columns
+   * \param position the new neighbor position
+   */
+  void SetNeighborPosition (uint32_t slot, Vector position);
+
+  /**
+   * \param time a simulation time
+   * \returns the first expiry wheel tick not before time
+   */
+  uint64_t GetExpiryTick (Time time) const;
+
+  /**
+   * \returns the last expiry wheel tick reached by the simulation time
+   */
+  uint64_t GetCurrentExpiryTick (void) const;
+
+  /**
+   * \brief Make a neighbor expire at a wheel tick unless heard again
+   * \param slot the position of the neighbor in the columns
+   * \param deadline the expiry tick
+   */
+  void ScheduleNeighborExpiry (uint32_t slot, uint64_t deadline);
+
+  /**
+   * \brief Schedule the expiry event at the next wheel tick holding entries
+   */
+  void ScheduleExpiryEvent (void);
+
+  /**
+   * \brief Remove the neighbors not heard for NeighborMaxAge
+   */
+  void ExpireNeighbors (void);
+
+  /**
+   * \brief Choose the NL entry to drop when the NL is full
+   * \returns the position of the stalest, farthest, highest hop entry
+   */
+  uint32_t FindEvictionCandidate (void) const;
+
+  /**
+   * \brief Register the best of some unknown nodes in a full NL
+   * \param candidates the unknown nodes, with their information time
+   * \returns the number of candidates registered
+   */
+  uint32_t AdmitNeighbors (const std::vector<struct Neighbor> &candidates);
+
+  /**
+   * \brief Keep only the first n entries of every NL column
+   * \param n the new number of entries
+   */
+  void ResizeNeighbors (uint32_t n);
+
+  /**
+   * \brief Find a node in the malicious list
+   * \param ip the node IP address
+   * \returns the malicious list entry or 0 if ip is not in the list
+   */
+  struct MaliciousNode *LookupMaliciousNode (Ipv4Address ip);
+
+  NeighborColumns m_neighbors;                  //!< Neighbor list in the node
+  Ipv4AddressIndex m_neighborIndex;             //!< Neighbor IP to m_neighbors position
+  uint64_t m_neighborsVersion;                  //!< Incremented on every NL change
+  Ptr<const NeighborSnapshot> m_neighborSnapshot; //!< Last NL snapshot handed out
+  Time m_neighborMaxAge;                        //!< Age of expiry of a neighbor not heard, 0 disables
+  Time m_neighborExpiryResolution;              //!< Duration of an expiry wheel tick
+  NeighborTimerWheel m_expiryWheel;             //!< Pending neighbor expiries
+  uint32_t m_maxNeighbors;                      //!< NL capacity, 0 for no limit
+  EventId m_expiryEvent;                        //!< Next expiry wheel advance
+  MaliciousNodeHandlerList m_MaliciousNodeList; //!< Malicious node list in the node
+  std::vector<Ipv4Address> m_maliciousIps;      //!< m_MaliciousNodeList addresses, in the same order
+  Ipv4AddressIndex m_maliciousIndex;            //!< Malicious node IP to m_MaliciousNodeList position
+  Vector m_position;                            //!< Store node position
+  u_int8_t m_state;                             //!< Store node state (0 ordinary, 1 malicious)
+};
+
+} // namespace ns3
+
+#endif /* FLYSAFE_NEIGHBOR_TABLE_H */
@@ -22,6 +22,8 @@
 // George F. Riley, Georgia Tech, Spring 2007
 // Adapted from ApplicationOnOff in GTNetS.
 
+#include <algorithm>
+
 #include "ns3/log.h"
 #include "ns3/address.h"
 #include "ns3/inet-socket-address.h"
@@ -42,6 +44,7 @@
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/ipv4.h"
 #include "ns3/mobility-module.h"
 #include "ns3/vector.h"
@@ -105,6 +108,42 @@ FlySafeOnOff::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&FlySafeOnOff::m_enableSeqTsSizeHeader),
                    MakeBooleanChecker ())
+    .AddAttribute ("PositionEncoding",
+                   "How positions are written in the FlySafe tags",
+                   EnumValue (MyTag::POSITION_DOUBLE),
+                   MakeEnumAccessor (&FlySafeOnOff::m_positionEncoding),
+                   MakeEnumChecker (MyTag::POSITION_DOUBLE, "Double",
+                                    MyTag::POSITION_CENTIMETERS, "Centimeters",
+                                    MyTag::POSITION_RELATIVE, "Relative"))
+    .AddAttribute ("TrapDeltaUpdates",
+                   "Send in trap messages only the NL entries changed since the previous round",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FlySafeOnOff::m_trapDelta),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TrapResyncInterval",
+                   "Interval between trap rounds sending the full NL, when TrapDeltaUpdates is set",
+                   TimeValue (Seconds (5.0)),
+                   MakeTimeAccessor (&FlySafeOnOff::m_trapResyncInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("TrapBroadcastThreshold",
+                   "Number of trap targets beyond which a round sends one broadcast trap, "
+                   "marking its targets, instead of a unicast to each. Zero always unicasts",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlySafeOnOff::m_trapBroadcastThreshold),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PayloadSize",
+                   "Size in bytes of the FlySafe messages payload with the tag transport. "
+                   "The payload carries no data, everything is in the tag",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&FlySafeOnOff::m_payloadSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MessageTransport",
+                   "How the FlySafe messages are carried: as a packet tag, taking no airtime, "
+                   "or as a header in the packet bytes",
+                   EnumValue (FlySafeHeader::TRANSPORT_TAG),
+                   MakeEnumAccessor (&FlySafeOnOff::m_transport),
+                   MakeEnumChecker (FlySafeHeader::TRANSPORT_TAG, "Tag",
+                                    FlySafeHeader::TRANSPORT_HEADER, "Header"))
     .AddTraceSource ("Tx", "A new packet is created and is sent",
                      MakeTraceSourceAccessor (&FlySafeOnOff::m_txTrace),
                      "ns3::Packet::TracedCallback")
@@ -126,6 +165,9 @@ FlySafeOnOff::GetTypeId (void)
     .AddTraceSource ("EmptyNLTraces", "Monitor nodes with empty NL",
                      MakeTraceSourceAccessor (&FlySafeOnOff::m_emptyNLTraces),
                      "ns3::FlySafeOnOff::TracedCallback")
+    .AddTraceSource ("QuantizationTraces", "Position error of a sent tag, due to its position encoding",
+                     MakeTraceSourceAccessor (&FlySafeOnOff::m_quantizationTrace),
+                     "ns3::FlySafeOnOff::TracedCallback")
   ;
   return tid;
 }
@@ -160,6 +202,7 @@ void FlySafeOnOff::Setup(Address address, uint32_t protocolId, double maliciousT
   m_peer = address;
   m_node = GetNodeIpAddress();
   m_nodeIP = InetSocketAddress::ConvertFrom(m_node).GetIpv4();
+  m_table = FlySafeNeighborTable::Install(GetNode()); // NL/SL live beside the node - Feb 12, 24
   
   m_searchNeighbors = true;
 
@@ -171,6 +214,7 @@ void FlySafeOnOff::Setup(Address address, uint32_t protocolId, double maliciousT
 
   m_maliciousTime = maliciousTime;
   m_maliciousRegister = false;
+  m_lastTrapResync = -1.0;
 }
 
 
@@ -216,6 +260,8 @@ FlySafeOnOff::DoDispose (void)
 
   CancelEvents ();
   m_socket = 0;
+  m_unicastSocket = 0;
+  m_table = 0;
   m_unsentPacket = 0;
   // chain up
   Application::DoDispose ();
@@ -234,10 +280,13 @@ void FlySafeOnOff::StartApplication ()
   // As node is created and set on coordinates (0,0,0),
   // we update its position with the information from the mobility model
   Vector position = GetNodeActualPosition();
-  Ptr<Node> ThisNode = this->GetNode();
-  ThisNode->SetPosition(position);
+  m_table->SetPosition(position);
   // ----------------------
-  // ThisNode->RegisterNeighbor(m_peer,position); //Setup one neighbor in the list
+  if (m_transport == FlySafeHeader::TRANSPORT_HEADER) // The NL sent must fit in one header - Feb 25, 24
+    {
+      m_table->LimitNeighbors (FlySafeHeader::GetMaxNeighbors (m_positionEncoding));
+    }
+  // m_table->RegisterNeighbor(m_peer,position); //Setup one neighbor in the list
 
   // Create the socket if not already
   if (!m_socket)
@@ -306,6 +355,11 @@ void FlySafeOnOff::StopApplication () // Called at time specified by Stop
     {
       NS_LOG_WARN ("FlySafeOnOff found null socket to close in StopApplication");
     }
+  if (m_unicastSocket != 0)
+    {
+      m_unicastSocket->Close ();
+      m_unicastSocket = 0;
+    }
 }
 
 
@@ -443,17 +497,12 @@ void FlySafeOnOff::SendPacket ()
 
   NS_ASSERT (m_sendEvent.IsExpired ());
 
-  std::vector<NeighInfos> neighListVector;
-  // Variables to recover node NL
-  std::vector<ns3::MyTag::NeighInfos> nodeInfosVectorTag; 
-  ns3::MyTag::NeighInfos nodeInfo;
   std::vector<ns3::MyTag::MaliciousNode> maliciousList;
 
   double timeNow;
   //Vector nodePosition;
-  std::vector<ns3::MyTag::NeighborFull> neighListFull;
+  Ptr<const NeighborSnapshot> neighListFull;
 
-  Ptr<Node> ThisNode = this->GetNode();
   
   // Tag value 0: Broadcast - Search neighbors (Hello message)
   // 		       1: Unicast - Identification (Location message)
@@ -468,13 +517,14 @@ void FlySafeOnOff::SendPacket ()
   Vector position = GetNodeActualPosition();
   timeNow = Simulator::Now().GetSeconds();
 
-  if (ThisNode->IsMoving(position)){
-     ThisNode->SetPosition(position); // Save for future comparaison
-     if(ThisNode->IsThereAnyNeighbor() && !m_searchNeighbors) {
-        DecreaseNeighborsQuality();
-        CleanNeighborsList();         // Remove nodes with quality 0 from NL  
+  if (m_table->IsMoving(position)){
+     m_table->SetPosition(position); // Save for future comparaison
+     if(m_table->IsThereAnyNeighbor() && !m_searchNeighbors) {
+        if (!m_table->IsNeighborExpiryEnabled()) {
+          CleanNeighborsList();         // Decrease NL quality and remove nodes with quality 0 from NL  
+        }                               // Otherwise the node expires stale neighbors by itself
 
-        if((int)ThisNode->GetState() == 1){ // Node will be malcious?
+        if((int)m_table->GetState() == 1){ // Node will be malcious?
           if (timeNow >= m_maliciousTime){ // Time to becom malicious
               if (!m_maliciousRegister){
               cout << m_nodeIP << " : " << timeNow << " FlySafeOnOff - Turn to malicious operation!" << endl;
@@ -488,7 +538,7 @@ void FlySafeOnOff::SendPacket ()
           }
         }
 
-        if (ThisNode->IsThereAnyNeighbor(1)) {
+        if (m_table->IsThereAnyNeighbor(1)) {
           notifyNewPosition(position);  // Update neighbors with new position
           PrintMyNeighborList();
         }
@@ -512,7 +562,7 @@ void FlySafeOnOff::SendPacket ()
      //else
      
      
-     if((int)ThisNode->GetState() == 1){ // Node will be malcious?
+     if((int)m_table->GetState() == 1){ // Node will be malcious?
        if (timeNow >= m_maliciousTime){ // Time to becom malicious
           if (!m_maliciousRegister){
           cout << m_nodeIP << " : " << timeNow << " FlySafeOnOff - Turn to malicious operation!" << endl;
@@ -527,42 +577,26 @@ void FlySafeOnOff::SendPacket ()
      }
 
      if(m_searchNeighbors) {  // Search neighbors sending a broadcast message
-        if (!ThisNode->IsThereAnyNeighbor(1) && ThisNode->IsThereAnyNeighbor()){ // If no 1 hop neighbor(s) in NL, clean up NL
-          ThisNode->ClearNeighborList();
+        if (!m_table->IsThereAnyNeighbor(1) && m_table->IsThereAnyNeighbor()){ // If no 1 hop neighbor(s) in NL, clean up NL
+          m_table->ClearNeighborList();
           std::cout << m_nodeIP << " : " << timeNow 
                     << " FlySafeOnOff - Cleaned up my Neighbor List!"
                     << std::endl; 
         }
         m_searchNeighbors = false;
-        Ptr<Packet> packet = Create<Packet>(reinterpret_cast<const uint8_t *>("Hello!"), 6);  // Create a packet
-        MyTag broadcastTag;                 // Create a tag
 
         std::cout << "\n" << m_nodeIP << " : " << timeNow 
                   << " FlySafeOnOff - Search neighbors from position x: "
                   << position.x << " y: " << position.y << " z: " << position.z 
                   << "\n" << std::endl; 
 
-        broadcastTag.SetSimpleValue(0);     // Add value to tag
-        broadcastTag.SetNNeighbors(ThisNode->GetNNeighbors());      // Broadcast only with NL = 0       
-        broadcastTag.SetPosition(position); // Add nodes positin to tag
-        broadcastTag.SetMessageTime(timeNow);
-
-        if (ThisNode->GetNNeighbors() != 0){ // Get NL and add to tag
-          neighListVector = GetNeighborListVector();
-
-          for(auto n :neighListVector){ // Copy NL to a MyTag::NeighInfos vector type
-            nodeInfo.ip = n.ip;
-            nodeInfo.x = n.x;
-            nodeInfo.y = n.y;
-            nodeInfo.z = n.z; 
-            nodeInfo.hop = n.hop;
-            nodeInfo.state = n.state;
-            nodeInfosVectorTag.push_back(nodeInfo);
-          }
-        }  
-        broadcastTag.SetNeighInfosVector(nodeInfosVectorTag);
-        
-        packet->AddPacketTag(broadcastTag); // Add tag to the packet
+        m_txTag.SetSimpleValue(0);     // Add value to tag
+        m_txTag.SetNNeighbors(m_table->GetNNeighbors());      // Broadcast only with NL = 0       
+        m_txTag.SetPosition(position); // Add nodes positin to tag
+        m_txTag.SetMessageTime(timeNow);
+        LoadNeighInfos(m_txTag); // Get NL and add to tag
+
+        Ptr<Packet> packet = CreateMessage(m_txTag); // Fixed size payload - Feb 22, 24
         
         m_txTrace(packet);
         m_socket->Send(packet);
@@ -583,7 +617,7 @@ void FlySafeOnOff::SendPacket ()
             NS_LOG_INFO(m_nodeIP << ":" << Simulator::Now().GetSeconds()
                                 << ": Sent message to "
                                 << receiverAddress.GetIpv4() << " - Tag "
-                                << (int)broadcastTag.GetSimpleValue());
+                                << (int)m_txTag.GetSimpleValue());
           }
           m_txTraceWithAddresses(packet, localAddress, receiverAddress);
         }
@@ -666,52 +700,95 @@ Vector FlySafeOnOff::GetNodeActualPosition()
 }
 
 
+/**
+ * @brief Order NL entries by IP, as needed by MyTag::GetChangedNeighInfos
+ * @date Feb 20, 2024
+ */
+static bool NeighInfosIpLess(const ns3::MyTag::NeighInfos &a, const ns3::MyTag::NeighInfos &b) {
+  return a.ip < b.ip;
+}
+
+
 /**
  * @brief Update neighbors nodes with nodes new position (trap message)
  * @date 29Sep2022
+ * @date Feb 20, 2024 - Delta NL to neighbors trapped in the previous round
+ * @date Feb 22, 2024 - NL and messages built once per round
+ * @date Feb 25, 2024 - One broadcast trap beyond TrapBroadcastThreshold targets
+ * @date Feb 25, 2024 - Each message built only when a target needs it
  * 
  * @param position - Vector with nodes position (x, y, z)
  * @returns NIL
  */
 void FlySafeOnOff::notifyNewPosition(Vector position){
   
-  vector<Ipv4Address> neighborList;
-  std::vector<NeighInfos> neighInfosVector;
-  Address neighIPPort;
   double timeNow;
   //ostringstream trapString;
 
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList(); // get node neighbors list
-  neighInfosVector = GetNeighborListVector();
-
-  MyTag tag;
-  std::vector<ns3::MyTag::NeighInfos> neighInfosVectorTag; 
-  std::vector<ns3::MyTag::NeighborFull> neighListFull;
-
-  ns3::MyTag::NeighInfos nodeInfo;
-
-	for(auto n :neighInfosVector){ // Copy NL to a MyTag::NeighInfos vector type
-		nodeInfo.ip = n.ip;
-		nodeInfo.x = n.x;
-		nodeInfo.y = n.y;
-		nodeInfo.z = n.z; 
-    nodeInfo.hop = n.hop;
-    nodeInfo.state = n.state;
-    neighInfosVectorTag.push_back(nodeInfo);
-	}
-
-  tag.SetSimpleValue(2); // Tag value 2: Unicast - Update location (Trap message)
-  tag.SetNNeighbors((uint32_t)ThisNode->GetNNeighbors()); // Add the number of neighbor nodes to tag
-  tag.SetPosition(position); // Add nodes positin to tag
-  tag.SetNeighInfosVector(neighInfosVectorTag);
+  Ptr<const NeighborSnapshot> neighListFull;
 
   timeNow = Simulator::Now().GetSeconds();
   neighListFull = GetNeighborIpListFull();
 
-  tag.SetMessageTime(timeNow);
+  m_txTag.SetSimpleValue(2); // Tag value 2: Unicast - Update location (Trap message)
+  m_txTag.SetNNeighbors((uint32_t)m_table->GetNNeighbors()); // Add the number of neighbor nodes to tag
+  m_txTag.SetPosition(position); // Add nodes positin to tag
+  m_txTag.SetMessageTime(timeNow);
+  LoadNeighInfos(m_txTag);
+
+  // Special identification and trap targets are all closer than 86 m, as
+  // measured when each neighbor was last heard. The position sent may be a
+  // false location, so it is not used to select them
+  std::vector<FlySafeNeighborTable::Neighbor> closeNeighbors = m_table->GetNeighborsCloserThan(86);
+  std::vector<Ipv4Address> trapTargets;
+
+  for (auto neighbor : closeNeighbors) { // Trap messages go to one hop neighbors only
+    if((int)neighbor.hop == 1 && neighbor.distance < 85){ 
+      trapTargets.push_back(neighbor.ip);
+    }
+  }
+  std::sort(trapTargets.begin(), trapTargets.end());
+
+  // Beyond the threshold a single broadcast reaches every target. They are
+  // marked in the NL sent, the other receivers drop the trap - Feb 25, 24
+  bool broadcastTrap = m_trapBroadcastThreshold > 0 && trapTargets.size() > m_trapBroadcastThreshold;
+
+  // Every target of the round receives a copy of the same message. Copies
+  // share the payload and the tag, so the NL is serialized once - Feb 22, 24
+  Ptr<Packet> trapMessage;    // Created on first use - Feb 25, 24
+  Ptr<Packet> deltaMessage;   // Created on first use
+  Ptr<Packet> specialMessage; // Created on first use
+
+  // Delta mode: neighbors trapped in the previous round already have its NL,
+  // so they receive only the entries changed since then. Everyone else, and
+  // everyone at each resync, receives the full NL. Entries removed from the
+  // NL are not sent, the receivers age them out by themselves - Feb 20, 24
+  bool resync = !m_trapDelta || m_lastTrapResync < 0 
+                || timeNow - m_lastTrapResync >= m_trapResyncInterval.GetSeconds();
+  std::vector<ns3::MyTag::NeighInfos> sortedList;
+  std::vector<ns3::MyTag::NeighInfos> knownList; // NL the delta targets have after this round
+  MyTag deltaTag;
+
+  if (m_trapDelta) {
+    sortedList = m_txTag.GetNeighInfosVector();
+    std::sort(sortedList.begin(), sortedList.end(), &NeighInfosIpLess);
+  }
+  if (m_trapDelta && !broadcastTrap) { // A broadcast trap carries the full NL
+    deltaTag.SetSimpleValue(2);
+    deltaTag.SetNNeighbors(m_txTag.GetNNeighbors());
+    deltaTag.SetPosition(position);
+    deltaTag.SetMessageTime(timeNow);
+    // Entries heard again are sent once the receivers' time of them is half
+    // a NeighborMaxAge old, before they expire them. Without expiry, half a
+    // resync interval - Feb 25, 24
+    TimeValue maxAge;
+    m_table->GetAttribute("NeighborMaxAge", maxAge);
+    double maxInfoShift = (m_table->IsNeighborExpiryEnabled() ? maxAge.Get() : m_trapResyncInterval).GetSeconds() / 2;
+    deltaTag.SetNeighInfosVector(MyTag::GetChangedNeighInfos(m_lastTrapList, sortedList, maxInfoShift, &knownList));
+    deltaTag.SetDeltaList(true);
+  }
 
-  // if((int)ThisNode->GetState() == 1){ // Node will be malcious?
+  // if((int)m_table->GetState() == 1){ // Node will be malcious?
   //   if (timeNow >= m_maliciousTime){ // Time to becom malicious
   //     cout << m_nodeIP << " : " << timeNow << " FlySafeOnOff - Turn to malicious operation!" << endl;
   //     cout << m_nodeIP << " : " << timeNow << " FlySafeOnOff - Real position is " 
@@ -722,66 +799,99 @@ void FlySafeOnOff::notifyNewPosition(Vector position){
   //   }
   // }
 
+  if (broadcastTrap) {
+    cout << m_nodeIP << " : " << timeNow 
+         << " FlySafeOnOff - Sent trap message by broadcast from new position x: "
+         << position.x << " y: " << position.y << " z: " 
+         << position.z << " to " << trapTargets.size() << " neighbors - I have " 
+         << (uint32_t)m_table->GetNNeighbors() << " neighbors" << std::endl; 
+
+    cout << m_nodeIP << " : " << timeNow 
+         << " FlySafeOnOff - NL sent within trap message:" << std::endl;
+    PrintNeighborList(m_txTag.GetNeighInfosVector());
+
+    m_txTag.SetTrapTargets(trapTargets);
+    trapMessage = CreateMessage(m_txTag);
+    m_txTag.SetTrapTargets(std::vector<Ipv4Address>()); // The other messages are for every receiver
+    m_socket->Send(trapMessage);
+    for (auto target : trapTargets) { // Traced as the unicasts it replaces, each target traces its reception
+      m_txTraceMessage(timeNow, m_nodeIP, target, 2, "Trap", position, neighListFull); // Callback to messages sent
+    }
+  }
 
-  for (uint8_t i = 0; i < neighborList.size(); i++) {  // Check all neighbors nodes at 1 hop and send message
+  for (auto neighbor : closeNeighbors) {  // Check all neighbors nodes at 1 hop and send message
     
     // trapString.str("");
 
     // Send a special identification no neighbor nodes 1 hop away, but closer than 86 m
-    if((int)ThisNode->GetNeighborHop(neighborList[i]) > 1 && ThisNode->GetNeighborDistance(neighborList[i]) < 86){
+    if((int)neighbor.hop > 1 && neighbor.distance < 86){
       // 86m is the range to 802.11n
       
       cout << m_nodeIP << " : " << timeNow 
            << " FlySafeOnOff - Sent special identification message from new position x: "
            << position.x << " y: " << position.y << " z: " 
-           << position.z << " to " << neighborList[i] << ". It is " 
-           << (int)ThisNode->GetNeighborHop(neighborList[i]) << " hop(s) away at "
-           << (int)ThisNode->GetNeighborDistance(neighborList[i]) << " meters" << std::endl; 
-
-      neighIPPort = InetSocketAddress(neighborList[i], 9); // Register address with port = 9
+           << position.z << " to " << neighbor.ip << ". It is " 
+           << (int)neighbor.hop << " hop(s) away at "
+           << (int)neighbor.distance << " meters" << std::endl; 
 
-      SendMessage(neighIPPort,"Special identification",3, (uint32_t) ThisNode->GetNNeighbors(), position, neighInfosVectorTag);
+      if (!specialMessage) { // Same NL, tag value 3: Unicast - Special identification
+        m_txTag.SetSimpleValue(3);
+        specialMessage = CreateMessage(m_txTag);
+      }
+      SendMessageCopy(neighbor.ip, specialMessage);
 
       // Callback to trace messages sent
-      m_txTraceMessage(timeNow, m_nodeIP, neighborList[i], 3, "Special identification", position, neighListFull);
+      m_txTraceMessage(timeNow, m_nodeIP, neighbor.ip, 3, "Special identification", position, neighListFull);
     }
 
     // Send trap messages to one hop neighbors only
-    if((int)ThisNode->GetNeighborHop(neighborList[i]) == 1 && ThisNode->GetNeighborDistance(neighborList[i]) < 85){ 
+    if((int)neighbor.hop == 1 && neighbor.distance < 85 && !broadcastTrap){ 
       
       cout << m_nodeIP << " : " << timeNow 
            << " FlySafeOnOff - Sent trap message from new position x: "
            << position.x << " y: " << position.y << " z: " 
-           << position.z << " to " << neighborList[i] << " - I have " 
-           << (uint32_t)ThisNode->GetNNeighbors() << " neighbors" << std::endl; 
+           << position.z << " to " << neighbor.ip << " - I have " 
+           << (uint32_t)m_table->GetNNeighbors() << " neighbors" << std::endl; 
+
+      bool delta = !resync && std::binary_search(m_lastTrapTargets.begin(), m_lastTrapTargets.end(), neighbor.ip);
+      MyTag &trapTag = delta ? deltaTag : m_txTag;
 
       cout << m_nodeIP << " : " << timeNow 
-          << " FlySafeOnOff - NL sent within trap message:" << std::endl;
+          << (delta ? " FlySafeOnOff - NL changes sent within trap message:" 
+                    : " FlySafeOnOff - NL sent within trap message:") << std::endl;
     
-      PrintNeighborList(neighInfosVectorTag);
-
-      Address DestinyAddress(InetSocketAddress(neighborList[i], 9));
-      Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+      PrintNeighborList(trapTag.GetNeighInfosVector());
 
-      if (socket->Bind() == -1) {
-        NS_FATAL_ERROR("Failed to bind socket");
+      if (delta && !deltaMessage) {
+        deltaMessage = CreateMessage(deltaTag);
       }
+      if (!delta && !trapMessage) {
+        m_txTag.SetSimpleValue(2); // A special identification may have set 3
+        trapMessage = CreateMessage(m_txTag);
+      }
+      SendMessageCopy(neighbor.ip, delta ? deltaMessage : trapMessage);
 
-      socket->Connect(DestinyAddress);
-      Ptr<Packet> packet;
-      packet = Create<Packet>(reinterpret_cast<const uint8_t *>("Trap!"),5); // Create a packet to send the message 
-      packet->AddPacketTag(tag); // add the tag to packet
-      socket->Send(packet); // Send packet
-      socket->Close();  // Close socket
+      m_txTraceMessage(timeNow, m_nodeIP, neighbor.ip, 2, "Trap", position, neighListFull); // Callback to messages sent
+    }
 
-      m_txTraceMessage(timeNow, m_nodeIP, neighborList[i], 2, "Trap", position, neighListFull); // Callback to messages sent
-      
-      if((int)ThisNode->GetNeighborQuality(neighborList[i]) == 1){ // No answer form neigh node in last round
+    if((int)neighbor.hop == 1 && neighbor.distance < 85){ 
+      if((int)neighbor.quality == 1){ // No answer form neigh node in last round
         //register node data as empty list
         m_emptyNLTraces(timeNow, position, m_nodeIP, neighListFull);
       }
     }
   } 
+
+  if (m_trapDelta) { // Base of the next round deltas
+    m_lastTrapTargets.swap(trapTargets);
+    if (!resync && !broadcastTrap) {
+      m_lastTrapList.swap(knownList);
+    }
+    else { // Every target got the full NL
+      m_lastTrapList.swap(sortedList);
+      m_lastTrapResync = timeNow;
+    }
+  }
 }
 
 
@@ -793,184 +903,155 @@ void FlySafeOnOff::notifyNewPosition(Vector position){
  */
 
 void FlySafeOnOff::PrintMyNeighborList() {
-  vector<Ipv4Address> neighborList;
-  Vector position;
+  int nNeighbors = m_table->GetNNeighbors();
 
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-  
   cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
-       << " FlySafeOnOff - My neighbors are: "
-       << ThisNode->GetNNeighbors() << endl;
-       
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    position = ThisNode->GetNeighborPosition(neighborList[i]);
-    cout << neighborList[i] << " : Position x: " 
-         << position.x << " y: " << position.y << " z: " << position.z 
-         << " Distance: " << ThisNode->GetNeighborDistance(neighborList[i]) 
-         << "m Attitude: " << (int)ThisNode->GetNeighborAttitude(neighborList[i])
-         << " Quality: " << (int)ThisNode->GetNeighborQuality(neighborList[i])
-         << " Hop: " << (int)ThisNode->GetNeighborHop(neighborList[i])
-         << " State: " << (int)ThisNode->GetNeighborNodeState(neighborList[i]) << endl;
+       << " FlySafeOnOff - My neighbors are: " 
+       << nNeighbors << endl;
+
+  for (int i = 0; i < nNeighbors; i++) {
+    FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+    cout << neighbor.ip << " : Position x: " 
+         << neighbor.position.x << " y: " << neighbor.position.y << " z: " << neighbor.position.z 
+         << " Distance: " << neighbor.distance 
+         << "m Attitude: " << (int)neighbor.attitude
+         << " Quality: " << (int)neighbor.quality 
+         << " Hop: " << (int)neighbor.hop
+         << " State: " << (int)neighbor.state << endl;
   }
   cout << "\n" << endl;
 }
 
 /**
- * @brief Decrease the quality of each node neighbors in the NL
- * @date Jan 2, 2023
- * 
- * @returns NIL
- */
-
-void FlySafeOnOff::DecreaseNeighborsQuality() {
-  vector<Ipv4Address> neighborList;
-  u_int8_t quality;
-
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-  
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    quality = ThisNode->GetNeighborQuality(neighborList[i]);
-    if (quality > 0){
-      ThisNode->SetNeighborQuality(neighborList[i], --quality);
-    }
-  }
-}
-
-
-/**
- * @brief Remove nodes with quality 0 from NL
+ * @brief Decrease the quality of each node neighbors in the NL and
+ * remove nodes with quality 0 from NL
  * @date Jan 3, 2023
  * 
  * @returns NIL
  */
 
 void FlySafeOnOff::CleanNeighborsList() {
-  vector<Ipv4Address> neighborList;
+  // Suspicious nodes are never removed - Nov 9, 23
+  std::vector<FlySafeNeighborTable::Neighbor> evictedNeighbors = m_table->AgeAndEvictNeighbors();
 
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-  uint8_t i = 0;
-
-  for (i = 0; i < neighborList.size(); i++) {
-    if ((int)ThisNode->GetNeighborQuality(neighborList[i]) == 0 and 
-        (int)ThisNode->GetNeighborNodeState(neighborList[i]) == 0) { // Not remove suspicious nodes - Nov 9, 23
-      cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
-           << " FlySafeOnOff - Removing neighbor node "
-           << neighborList[i] << " with quality " << (int)ThisNode->GetNeighborQuality(neighborList[i]) 
-           << " hop " << (int)ThisNode->GetNeighborHop(neighborList[i]) 
-           << " and state " << (int)ThisNode->GetNeighborNodeState(neighborList[i]) 
-           << " from my NL" << std::endl;   
-      ThisNode->UnregisterNeighbor(neighborList[i]);
-    }
+  for (auto n : evictedNeighbors) {
+    cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
+         << " FlySafeOnOff - Removing neighbor node "
+         << n.ip << " with quality " << (int)n.quality 
+         << " hop " << (int)n.hop 
+         << " and state " << (int)n.state 
+         << " from my NL" << std::endl;   
   }
-  if ((int)ThisNode->GetNNeighbors() == 0){
+  if ((int)m_table->GetNNeighbors() == 0){
     cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
           << " FlySafeOnOff - My neighbor list is empty! \n" << std::endl; 
   }
 }
 
 /**
- * @brief Create a vector from node neigbor list
- * @date Feb 22, 2023
+ * @brief Load node NL into a tag, reusing the tag NL storage
+ * @date Feb 22, 2024
  * 
- * @param neighborList Vector with neighbor list Ipv4 Adress
+ * @param tag Tag to receive the NL
  */
+void FlySafeOnOff::LoadNeighInfos(MyTag &tag) {
+  std::vector<ns3::MyTag::NeighInfos> nodeInfos = tag.TakeNeighInfosVector();
+  ns3::MyTag::NeighInfos nodeInfo;
 
-std::vector<FlySafeOnOff::NeighInfos> FlySafeOnOff::GetNeighborListVector(){
-  vector<Ipv4Address> neighborList;
-  std::vector<FlySafeOnOff::NeighInfos> neighborListVector;
-  Vector position;
-  FlySafeOnOff::NeighInfos node;
-
-  neighborListVector.clear();
-  
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-  
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    position = ThisNode->GetNeighborPosition(neighborList[i]);
-		node.ip = neighborList[i];
-		node.x = position.x;
-		node.y = position.y;
-		node.z = position.z;
-    node.hop = ThisNode->GetNeighborHop(neighborList[i]);
-    node.state = ThisNode->GetNeighborNodeState(neighborList[i]);
-		neighborListVector.push_back(node);
-  }  
-  return neighborListVector;
+  int nNeighbors = m_table->GetNNeighbors();
+  nodeInfos.clear(); // Keeps the capacity of the previous rounds
+  nodeInfos.reserve(nNeighbors);
+
+  for (int i = 0; i < nNeighbors; i++) {
+    FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+    nodeInfo.ip = neighbor.ip;
+    nodeInfo.x = neighbor.position.x;
+    nodeInfo.y = neighbor.position.y;
+    nodeInfo.z = neighbor.position.z;
+    nodeInfo.hop = neighbor.hop;
+    nodeInfo.state = neighbor.state;
+    nodeInfo.infoTime = neighbor.infoTime;
+    nodeInfos.push_back(nodeInfo);
+  }
+  tag.SetNeighInfosVector(std::move(nodeInfos));
 }
 
+/**
+ * @brief Create a message with a fixed size payload and a FlySafe tag
+ * @date Feb 22, 2024
+ * 
+ * @param tag Tag with the message data
+ * @return Ptr<Packet> Message to send, or to copy for each destination
+ */
+Ptr<Packet> FlySafeOnOff::CreateMessage(MyTag &tag) {
+  // Zero filled payload, the header is the payload with the header transport
+  Ptr<Packet> packet = Create<Packet>(m_transport == FlySafeHeader::TRANSPORT_HEADER ? 0 : m_payloadSize);
+  AddMessageTag(packet, tag);
+  return packet;
+}
 
 /**
- * @brief Send a message to a neighbor node
- * @date Mar 08, 2023
+ * @brief Send a copy of a message to a neighbor node
+ * @date Feb 22, 2024
+ * @date Feb 24, 2024 - UDP messages share one socket
  * 
- * @param addressTo Neighbor node address (IPv4 + port)
- * @param message Message (string)
- * @param tagValue Tag value (0, 1, 2 or 3)
- * @param nNeigbors Number of neighbor nodes from the source node
- * @param nodePosition Source node position
+ * @param addressTo Neighbor node IPv4 address
+ * @param message Message created by CreateMessage
  */
-void FlySafeOnOff::SendMessage(Address addressTo, string message,
-                               uint8_t tagValue, u_int32_t nNeigbors, Vector nodePosition,
-                               std::vector<ns3::MyTag::NeighInfos> nodeInfos) {
+void FlySafeOnOff::SendMessageCopy(Ipv4Address addressTo, Ptr<const Packet> message) {
+  Address destinyAddress(InetSocketAddress(addressTo, 9));  // Add port 9 to destiny address
 
-  double timeNow;
+  if (m_tid != UdpSocketFactory::GetTypeId()) { // Connection oriented, one socket per message
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
 
-  Address destinyAddress(InetSocketAddress(
-      Ipv4Address(InetSocketAddress::ConvertFrom(addressTo).GetIpv4()), 9));  // Add port 9 to destiny address
-  Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+    if (socket->Bind() == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
 
-  if (socket->Bind() == -1) {
-    NS_FATAL_ERROR("Failed to bind socket");
+    socket->Connect(destinyAddress);
+    socket->Send(message->Copy()); // Copy on write, shares payload and tags
+    socket->Close();
+    return;
   }
 
-  socket->Connect(destinyAddress);
-  Ptr<Packet> packet;
+  if (!m_unicastSocket) { // One bound socket sends every unicast - Feb 24, 24
+    m_unicastSocket = Socket::CreateSocket(GetNode(), m_tid);
 
-  packet = Create<Packet>(reinterpret_cast<const uint8_t *>(message.c_str()),
-                          message.size());
-  MyTag tagToSend;
-  tagToSend.SetSimpleValue(tagValue);         // Add tag value
-  tagToSend.SetNNeighbors(nNeigbors);         // Add the number of neighbor nodes to tag
-  tagToSend.SetPosition(nodePosition);        // Add nodes positin to tag
-  tagToSend.SetNeighInfosVector(nodeInfos);   // Add nodes NL to tag
-  
-  timeNow = Simulator::Now().GetSeconds();
-  tagToSend.SetMessageTime(timeNow);
+    if (m_unicastSocket->Bind() == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+  }
+  m_unicastSocket->SendTo(message->Copy(), 0, destinyAddress); // Copy on write, shares payload and tags
+}
 
-  packet->AddPacketTag(tagToSend);
-  socket->Send(packet);
-  socket->Close();
+/**
+ * @brief Add a FlySafe tag to a packet, with the configured position encoding
+ * @date Feb 19, 2024
+ * @date Feb 23, 2024 - As a FlySafeHeader with the header transport
+ * 
+ * @param packet Packet to send
+ * @param tag Tag with the message data
+ */
+void FlySafeOnOff::AddMessageTag(Ptr<Packet> packet, MyTag &tag) {
+  tag.SetPositionEncoding(m_positionEncoding);
+  if (m_positionEncoding != MyTag::POSITION_DOUBLE) {
+    m_quantizationTrace(Simulator::Now().GetSeconds(), m_nodeIP, tag.GetQuantizationError());
+  }
+  if (m_transport == FlySafeHeader::TRANSPORT_HEADER) {
+    packet->AddHeader(FlySafeHeader(tag)); // Real bytes, sent on air - Feb 23, 24
+  } else {
+    packet->AddPacketTag(tag);
+  }
 }
 
 /**
  * @brief Get the Neighbor Ip List Full object
  * @date Apr 7, 2023
  * 
- * @return vector<ns3::MyTag::NeighborFull> 
+ * @return Ptr<const NeighborSnapshot> - Shared, immutable copy of the NL
  */
-vector<ns3::MyTag::NeighborFull> FlySafeOnOff::GetNeighborIpListFull() { 
-  vector<Ipv4Address> neighborList;
-  vector<ns3::MyTag::NeighborFull> neighListFull;
-  ns3::MyTag::NeighborFull NeighInfo;
-  Vector position;
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    NeighInfo.ip = neighborList[i];
-    NeighInfo.position = ThisNode->GetNeighborPosition(neighborList[i]);
-    NeighInfo.distance = ThisNode->GetNeighborDistance(neighborList[i]);
-    NeighInfo.hop = ThisNode->GetNeighborHop(neighborList[i]);
-    NeighInfo.state = ThisNode->GetNeighborNodeState(neighborList[i]);
-    NeighInfo.attitude = ThisNode->GetNeighborAttitude(neighborList[i]);
-    NeighInfo.quality = ThisNode->GetNeighborQuality(neighborList[i]);
-    neighListFull.push_back(NeighInfo);
-  }
-  return neighListFull;
+Ptr<const NeighborSnapshot> FlySafeOnOff::GetNeighborIpListFull() { 
+  return m_table->GetNeighborSnapshot(); // Rebuilt only when the NL changed - Feb 1, 24
 }
 
 /**
@@ -980,19 +1061,17 @@ vector<ns3::MyTag::NeighborFull> FlySafeOnOff::GetNeighborIpListFull() {
  * @return vector<ns3::MyTag::MaliciousNode> 
  */
 vector<ns3::MyTag::MaliciousNode> FlySafeOnOff::GetMaliciousNeighborList() { 
-  vector<Ipv4Address> maliciousIPList;
   vector<ns3::MyTag::MaliciousNode> maliciousListFull;
   ns3::MyTag::MaliciousNode maliciousInfo;
-  Vector position;
 
-  Ptr<Node> ThisNode = this->GetNode();
-  maliciousIPList = ThisNode->GetMaliciousNodeIpList();
+  Ipv4AddressRange maliciousIPList = m_table->GetMaliciousNodeIps();
+  maliciousListFull.reserve(maliciousIPList.size());
 
-  for (uint8_t i = 0; i < maliciousIPList.size(); i++) {
-    maliciousInfo.ip = maliciousIPList[i];
-    maliciousInfo.state = ThisNode->GetMaliciousNodeState(maliciousIPList[i]);
-    maliciousInfo.recurrence = ThisNode->GetMaliciousNodeRecurrence(maliciousIPList[i]);
-    maliciousInfo.notifyIP = ThisNode->GetMaliciousNodesIPNotifiers(maliciousIPList[i]);
+  for (const Ipv4Address &maliciousIP : maliciousIPList) {
+    maliciousInfo.ip = maliciousIP;
+    maliciousInfo.state = m_table->GetMaliciousNodeState(maliciousIP);
+    maliciousInfo.recurrence = m_table->GetMaliciousNodeRecurrence(maliciousIP);
+    maliciousInfo.notifyIP = m_table->GetMaliciousNodeNotifiers(maliciousIP).ToVector();
     maliciousListFull.push_back(maliciousInfo);
   }
   return maliciousListFull;
@@ -35,6 +35,8 @@
 #include "ns3/packet-socket-address.h"
 #include "ns3/vector.h"
 #include "flysafe-tag.h"
+#include "flysafe-header.h"
+#include "flysafe-neighbor-table.h"
 #include "ns3/utils.h"
 
 namespace ns3 {
@@ -136,19 +138,6 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
-  /**
-   * @brief Struct to store infos from a neighbor node
-   * @date 21022023
-   */
-  struct NeighInfos {
-        Ipv4Address ip;
-        double x;
-        double y;
-        double z;
-        uint8_t hop;
-        uint8_t state;
-  };
-
 protected:
   virtual void DoDispose (void);
 private:
@@ -201,50 +190,59 @@ private:
 
 
   /**
-   * @brief Decrease the quality of each node neighbors in the NL
-   * @date Jan 2, 2023
+   * @brief Decrease the quality of each node neighbors in the NL and
+   * remove nodes with quality 0 from NL
+   * @date Jan 3, 2023
    * 
    * @returns NIL
    */
-  void DecreaseNeighborsQuality();
+  void CleanNeighborsList();
+
 
   /**
-   * @brief Remove nodes with quality 0 from NL
-   * @date Jan 3, 2023
+   * @brief Load node NL into a tag, reusing the tag NL storage
+   * @date Feb 22, 2024
    * 
-   * @returns NIL
+   * @param tag Tag to receive the NL
    */
-  void CleanNeighborsList();
-
+  void LoadNeighInfos(MyTag &tag);
 
   /**
-   * @brief Create a vector from node neighbor list
+   * @brief Create a message with a fixed size payload and a FlySafe tag
+   * @date Feb 22, 2024
    * 
+   * @param tag Tag with the message data
+   * @return Ptr<Packet> Message to send, or to copy for each destination
    */
-  std::vector<NeighInfos> GetNeighborListVector();
+  Ptr<Packet> CreateMessage(MyTag &tag);
 
+  /**
+   * @brief Send a copy of a message to a neighbor node
+   * @date Feb 22, 2024
+   * @date Feb 24, 2024 - UDP messages share one socket
+   * 
+   * @param addressTo Neighbor node IPv4 address
+   * @param message Message created by CreateMessage
+   */
+  void SendMessageCopy(Ipv4Address addressTo, Ptr<const Packet> message);
 
   /**
-   * @brief Send a message to a neighbor node
-   * @date Mar 08, 2023
+   * @brief Add a FlySafe tag to a packet, with the configured position encoding
+   * @date Feb 19, 2024
+   * @date Feb 23, 2024 - As a FlySafeHeader with the header transport
    * 
-   * @param addressTo Neighbor node address (IPv4 + port)
-   * @param message Message (string)
-   * @param tagValue Tag value (0, 1, 2 or 3)
-   * @param nNeigbors Number of neighbor nodes from the source node
-   * @param nodePosition Source node position
+   * @param packet Packet to send
+   * @param tag Tag with the message data
    */
-  void SendMessage(Address addressTo, string message, uint8_t tagy, 
-                  u_int32_t nNeigbors, Vector nodePosition,
-                  std::vector<ns3::MyTag::NeighInfos> nodeInfos);
+  void AddMessageTag(Ptr<Packet> packet, MyTag &tag);
 
     /**
    * @brief Get the Neighbor Ip List Full object
    * @date Apr 7, 2023
    * 
-   * @return vector<ns3::MyTag::NeighborFull> 
+   * @return Ptr<const NeighborSnapshot> - Shared, immutable copy of the NL
    */
-  vector<ns3::MyTag::NeighborFull> GetNeighborIpListFull();
+  Ptr<const NeighborSnapshot> GetNeighborIpListFull();
 
     /**
    * @brief Get malicious neighbor list from the node
@@ -256,6 +254,8 @@ private:
   
 
   Ptr<Socket>     m_socket;                         //!< Associated socket
+  Ptr<Socket>     m_unicastSocket;                  //!< Bound socket sending the UDP unicasts
+  Ptr<FlySafeNeighborTable> m_table;                //!< FlySafe state aggregated to the node
   Address         m_peer;                           //!< Peer address
   Address         m_local;                          //!< Local address to bind to
   bool            m_connected;                      //!< True if connected
@@ -279,6 +279,16 @@ private:
   bool m_searchNeighbors;                           //!< True forces a neighbors search
   double m_maliciousTime;                           //!< Store the time a node becomes malicious (default: 9999.99)
   bool m_maliciousRegister;                         //!< Register wether a node becomes malicious
+  MyTag::PositionEncoding m_positionEncoding;       //!< How positions are written in the tags
+  bool m_trapDelta;                                 //!< Send only NL changes in trap messages
+  Time m_trapResyncInterval;                        //!< Interval between trap rounds with the full NL
+  double m_lastTrapResync;                          //!< Time of the last trap round with the full NL
+  std::vector<ns3::MyTag::NeighInfos> m_lastTrapList; //!< NL sent in the last trap round, by IP
+  std::vector<Ipv4Address> m_lastTrapTargets;       //!< Neighbors trapped in the last round, sorted
+  uint32_t m_trapBroadcastThreshold;                //!< Trap targets beyond which traps are broadcast (0: never)
+  uint32_t m_payloadSize;                           //!< Payload size of the FlySafe messages
+  MyTag m_txTag;                                    //!< Tag reused by the messages sent, keeps the NL storage
+  FlySafeHeader::Transport m_transport;             //!< How the messages are carried (tag or header)
 
   /// Traced Callback: transmitted packets.
   TracedCallback<Ptr<const Packet> > 
@@ -291,14 +301,16 @@ private:
   /// Callback for tracing the packet Tx events, includes source, destination, the packet sent, and header
   TracedCallback<Ptr<const Packet>, const Address &, const Address &, const SeqTsSizeHeader &> 
       m_txTraceWithSeqTsSize;
-  TracedCallback <double, Ipv4Address, Ipv4Address, int, string, Vector,std::vector<ns3::MyTag::NeighborFull>>
+  TracedCallback <double, Ipv4Address, Ipv4Address, int, string, Vector,Ptr<const NeighborSnapshot>>
       m_txTraceMessage; //!< Traced value to sent messages
-  TracedCallback<double, Vector, Ipv4Address, Ipv4Address, int, string, std::vector<ns3::MyTag::NeighborFull>, double>
+  TracedCallback<double, Vector, Ipv4Address, Ipv4Address, int, string, Ptr<const NeighborSnapshot>, double>
       m_stopTraces;            //!< Traced Callback: stopped nodes traces 
-  TracedCallback<double, Vector, Ipv4Address, std::vector<ns3::MyTag::NeighborFull>>
+  TracedCallback<double, Vector, Ipv4Address, Ptr<const NeighborSnapshot>>
       m_emptyNLTraces;            //!< Traced Callback: nodes with empty NL traces 
   TracedCallback<double, Ipv4Address, std::vector<ns3::MyTag::MaliciousNode>> 
       m_txMaliciousTraces;   //!< Traced Callback: malicious neighbors evolution 
+  TracedCallback<double, Ipv4Address, double>
+      m_quantizationTrace;   //!< Traced Callback: position error of the sent tags
 
 private:
   /**
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "flysafe-packet-sink.h"
 
 namespace ns3 {
@@ -20,6 +21,32 @@ TypeId FlySafePacketSink::GetTypeId(void) {
                         TypeIdValue(UdpSocketFactory::GetTypeId()),
                         MakeTypeIdAccessor(&FlySafePacketSink::m_tid),
                         MakeTypeIdChecker())
+          .AddAttribute("PositionEncoding",
+                        "How positions are written in the FlySafe tags",
+                        EnumValue(MyTag::POSITION_DOUBLE),
+                        MakeEnumAccessor(&FlySafePacketSink::m_positionEncoding),
+                        MakeEnumChecker(MyTag::POSITION_DOUBLE, "Double",
+                                        MyTag::POSITION_CENTIMETERS, "Centimeters",
+                                        MyTag::POSITION_RELATIVE, "Relative"))
+          .AddAttribute("PayloadSize",
+                        "Size in bytes of the FlySafe messages payload with the tag transport. "
+                        "The payload carries no data, everything is in the tag",
+                        UintegerValue(8),
+                        MakeUintegerAccessor(&FlySafePacketSink::m_payloadSize),
+                        MakeUintegerChecker<uint32_t>(1))
+          .AddAttribute("MessageTransport",
+                        "How the FlySafe messages are carried: as a packet tag, taking no airtime, "
+                        "or as a header in the packet bytes. Both are received",
+                        EnumValue(FlySafeHeader::TRANSPORT_TAG),
+                        MakeEnumAccessor(&FlySafePacketSink::m_transport),
+                        MakeEnumChecker(FlySafeHeader::TRANSPORT_TAG, "Tag",
+                                        FlySafeHeader::TRANSPORT_HEADER, "Header"))
+          .AddAttribute("AlertBatchDelay",
+                        "Time the suspect alerts are held to be sent with the following ones. "
+                        "Zero sends together the alerts raised at the same time",
+                        TimeValue(Seconds(0)),
+                        MakeTimeAccessor(&FlySafePacketSink::m_alertBatchDelay),
+                        MakeTimeChecker())
           .AddTraceSource("Rx", "A packet has been received",
                           MakeTraceSourceAccessor(&FlySafePacketSink::m_rxTrace),
                           "ns3::Packet::AddressTracedCallback")
@@ -34,6 +61,9 @@ TypeId FlySafePacketSink::GetTypeId(void) {
                           "ns3::FlySafePacketSink::TracedCallback")
           .AddTraceSource("TxTraces", "A new message is created and is sent",
                           MakeTraceSourceAccessor (&FlySafePacketSink::m_txTrace),
+                          "ns3::FlySafePacketSink::TracedCallback")
+          .AddTraceSource("QuantizationTraces", "Position error of a sent tag, due to its position encoding",
+                          MakeTraceSourceAccessor (&FlySafePacketSink::m_quantizationTrace),
                           "ns3::FlySafePacketSink::TracedCallback");
   return tid;
 }
@@ -63,8 +93,7 @@ void FlySafePacketSink::Setup(Address toAddress, uint32_t protocolId, double mal
   m_local = toAddress;
   m_socket = 0;
   m_totalRx = 0;
-
-  Ptr<Node> ThisNode = this->GetNode();
+  m_table = FlySafeNeighborTable::Install(GetNode()); // NL/SL live beside the node - Feb 12, 24
 
   if (protocolId == 1) // 1 Udp
     m_tid = ns3::UdpSocketFactory::GetTypeId();
@@ -75,11 +104,24 @@ void FlySafePacketSink::Setup(Address toAddress, uint32_t protocolId, double mal
   m_maliciousRegister = false;
 }
 
+/**
+ * @brief Release the sockets and the neighbor table
+ */
+void FlySafePacketSink::DoDispose(void) {
+  NS_LOG_FUNCTION(this);
+  m_socket = 0;
+  m_unicastSocket = 0;
+  m_table = 0;
+  // chain up
+  Application::DoDispose();
+}
+
 /**
  * @brief Stop FlySafePacketSink application
  */
 void FlySafePacketSink::StopApplication() {
   NS_LOG_FUNCTION(this);
+  Simulator::Cancel(m_alertEvent);
   while (!m_socketList.empty()) // these are accepted sockets, close them
   {
     Ptr<Socket> acceptedSocket = m_socketList.front();
@@ -90,6 +132,10 @@ void FlySafePacketSink::StopApplication() {
     m_socket->Close();
     m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
   }
+  if (m_unicastSocket) {
+    m_unicastSocket->Close();
+    m_unicastSocket = 0;
+  }
 }
 
 
@@ -99,6 +145,10 @@ void FlySafePacketSink::StopApplication() {
 void FlySafePacketSink::StartApplication() {
   NS_LOG_FUNCTION(this);
  
+  if (m_transport == FlySafeHeader::TRANSPORT_HEADER) { // The NL sent must fit in one header - Feb 25, 24
+    m_table->LimitNeighbors(FlySafeHeader::GetMaxNeighbors(m_positionEncoding));
+  }
+
   if (!m_socket) { // Create the socket if not already
     m_socket = Socket::CreateSocket(GetNode(), m_tid);
     m_socket->SetAllowBroadcast(true);
@@ -132,6 +182,7 @@ void FlySafePacketSink::StartApplication() {
 
 /**
  * @brief Handle a packet received from a neighbor node
+ * @date Feb 25, 2024 - Broadcast traps not addressed to the node are ignored
  * 
  * @param socket Socket received
  */
@@ -142,14 +193,10 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
   Address neighIPPort;
   Address localAddress;
   Ipv4Address neighIP;    // Store neighbor node IPv4 to display
-  string newBuffer;
-  string oldBuffer;
   double distance, value;
   double oldDistance;     // Store the old neighbor node distance
   uint8_t neighAttitude;  // Store the new neighbor node attitude
   Vector nodePosition;    // Store node position
-  vector<Ipv4Address> neighborList; // Store node neighbors list 
-  std::vector<FlySafePacketSink::NeighInfos> neighborListVector; // Store node NL
   double timeNow;
   int nNeigh; // Store number of neigbhors in the node neighbors list
   //uint8_t nState; // neighbor operation state (0 ordinary, 1 suspect)
@@ -171,15 +218,9 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
   uint32_t numberNNeighbors;                                // Store the number of neighbors in the neighbor node NL
   Vector position;                                          // Store neighbor node position (x, y, z)
 
-  Ptr<Node> ThisNode = this->GetNode();  
   nodePosition = GetNodeActualPosition();
-  neighborList = ThisNode->GetNeighborIpList();
 
-  // Variables to recover node NL
-  std::vector<NeighInfos> nodeInfosVector;
-  std::vector<ns3::MyTag::NeighInfos> nodeInfosVectorTag; 
-  ns3::MyTag::NeighInfos nodeInfo;
-  std::vector<ns3::MyTag::NeighborFull> neighListFull; 
+  Ptr<const NeighborSnapshot> neighListFull; 
   std::vector<ns3::MyTag::MaliciousNode> maliciousList;
 
   while ((packet = socket->RecvFrom(neighAdd))) {
@@ -192,33 +233,38 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
     m_totalRx += packet->GetSize();
 
     if (InetSocketAddress::IsMatchingType(neighAdd)) {
-      newBuffer = "";
-      newBuffer.clear();
-      uint8_t *buffer = new uint8_t[packet->GetSize()];
-      packet->CopyData(buffer, packet->GetSize());
-      newBuffer = (char *)buffer;
-
-      nNeigh = ThisNode->GetNNeighbors();
-
-      if(nNeigh != 0){ // Recover node NL only if node NL != 0. So, create a vector with NL
-        nodeInfosVector = GetNeighborListVector();
-
-        for(auto n :nodeInfosVector){ // Copy NL to a MyTag::NeighInfos vector type
-          nodeInfo.ip = n.ip;
-          nodeInfo.x = n.x;
-          nodeInfo.y = n.y;
-          nodeInfo.z = n.z; 
-          nodeInfo.hop = n.hop;
-          nodeInfo.state = n.state;
-          nodeInfosVectorTag.push_back(nodeInfo);
+      nNeigh = m_table->GetNNeighbors();
+
+      // Recover tag from packet and the information inside it. Without
+      // tag, the message was sent in a FlySafeHeader - Feb 23, 24
+      if (!packet->PeekPacketTag(receivedTag)) {
+        FlySafeHeader header;
+        if (packet->PeekHeader(header) == 0) { // Not read to its full length
+          cout << m_nodeIP << " : " << Simulator::Now().GetSeconds()
+               << " FlySafePacketSink - Message from " << neighIP
+               << " without a valid FlySafe header - Ignored!" << endl;
+          goto ignore_blocked_node;
         }
-      }  
+        receivedTag = std::move(header.GetTag());
+      }
 
-      // Recover tag from packet and the information inside it
-      packet->PeekPacketTag(receivedTag);
+      // A broadcast trap marks its targets in the NL. The other receivers
+      // escape its analysis, as done for blocked nodes - Feb 25, 24
+      if (receivedTag.HasTrapTargets() && !receivedTag.IsTrapTarget(m_nodeIP)) {
+        cout << m_nodeIP << " : " << Simulator::Now().GetSeconds()
+             << " FlySafePacketSink - Trap broadcast by " << neighIP
+             << " is not addressed to me - Ignored!" << endl;
+        goto ignore_blocked_node;
+      }
+
+      // Only hello and special identification messages are answered with
+      // the NL, taken before the analysis below changes it - Feb 22, 24
+      if (receivedTag.GetSimpleValue() == 0 || receivedTag.GetSimpleValue() == 3) {
+        LoadNeighInfos(m_txTag);
+      }
       position = receivedTag.GetPosition();
       numberNNeighbors = receivedTag.GetNNeighbors();
-      neighInfosVectorTag = receivedTag.GetNeighInfosVector(); // Get the NL from the received tag
+      neighInfosVectorTag = receivedTag.TakeNeighInfosVector(); // Move the NL out of the received tag
       
       std::cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
                             << " FlySafePacketSink - NL recovered from received packet from "
@@ -230,7 +276,7 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
       value = CalculateNodesDistance(nodePosition, position); // Calculate distance between nodes
       distance = std::ceil(value * 100.0) / 100.0; // 2 decimal cases
       
-      oldDistance = ThisNode->GetNeighborDistance (neighIP); // Get the old neighbor node distance from this node 
+      oldDistance = m_table->GetNeighborDistance (neighIP); // Get the old neighbor node distance from this node 
       neighAttitude = CheckNeighAttitude(distance, oldDistance);      
       
       timeNow = Simulator::Now().GetSeconds();
@@ -240,13 +286,13 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
       // 30/10/2023
       cout << m_nodeIP << " : " << timeNow 
            << " FlySafePacketSink - Message received from " << neighIP << " at " << distance << " meters!" << endl;
-      if (ThisNode->IsAMaliciousNode(neighIP)){ // The neighbor is already malicious?
+      if (m_table->IsAMaliciousNode(neighIP)){ // The neighbor is already malicious?
           cout << m_nodeIP << " : " << timeNow 
                << " FlySafePacketSink - Message received from suspicious node " << neighIP << " - Starting analysis!" << endl;
           PrintMyNeighborList();
           PrintMySupiciousList();
           
-          if (ThisNode->IsABlockedNode(neighIP)){ // The malicious neighbor is blocked?
+          if (m_table->IsABlockedNode(neighIP)){ // The malicious neighbor is blocked?
             cout << m_nodeIP << " : " << timeNow 
                  << " FlySafePacketSink - Message received from blocked node " << neighIP << " - Ignored!" << endl;
             maliciousList = GetMaliciousNeighborList();
@@ -254,16 +300,16 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             goto ignore_blocked_node; // Escape analysis of blocked node messages
             } 
           else if (distance > 115) { // The malicious neighbor repeat a false location information?
-            ThisNode->IncreaseMaliciousNodeRecurrence(neighIP, m_nodeIP);
+            m_table->IncreaseMaliciousNodeRecurrence(neighIP, m_nodeIP);
             cout << m_nodeIP << " : " << timeNow 
                  << " FlySafePacketSink - Malicious node " << neighIP << " recurrence is "
-                 << (int)ThisNode->GetMaliciousNodeRecurrence(neighIP) << endl;
+                 << (int)m_table->GetMaliciousNodeRecurrence(neighIP) << endl;
             
-            if (ThisNode->GetMaliciousNodeRecurrence(neighIP) == 3){ // Is the 3rd recurrence?
+            if (m_table->GetMaliciousNodeRecurrence(neighIP) == 3){ // Is the 3rd recurrence?
                 cout << m_nodeIP << " : " << timeNow 
                      << " FlySafePacketSink - Node " << neighIP << " blocked!" << endl;
-                ThisNode->SetMaliciousNodeState(neighIP, 1); // set blocked
-                ThisNode->UnregisterNeighbor(neighIP);
+                m_table->SetMaliciousNodeState(neighIP, 1); // set blocked
+                m_table->UnregisterNeighbor(neighIP);
                 NotifyNeighbors(neighIP, position, 1, 5); // Nofity about blocked neighbor
                 maliciousList = GetMaliciousNeighborList();
                 m_sinkMaliciousTrace(timeNow, m_nodeIP, maliciousList);
@@ -281,16 +327,16 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
           else { // Malicious node sent a true location
             cout << m_nodeIP << " : " << timeNow 
                    << " FlySafePacketSink - Received from malicious node " << neighIP << " a true location!" << endl;
-            ThisNode->DecreaseMaliciousNodeRecurrence(neighIP, m_nodeIP);
+            m_table->DecreaseMaliciousNodeRecurrence(neighIP, m_nodeIP);
             cout << m_nodeIP << " : " << timeNow 
                    << " FlySafePacketSink - Decreased malicious node " << neighIP << " recurrence!" << endl;
-            if (ThisNode->GetMaliciousNodeRecurrence(neighIP) == 0){ // Nodes became honest
+            if (m_table->GetMaliciousNodeRecurrence(neighIP) == 0){ // Nodes became honest
               PrintMyNeighborList();
               PrintMySupiciousList();
-              ThisNode->UnregisterMaliciousNode(neighIP);
+              m_table->UnregisterMaliciousNode(neighIP);
               cout << m_nodeIP << " : " << timeNow 
                    << " FlySafePacketSink - Removed node " << neighIP << " from SL!" << endl;
-              ThisNode->SetNeighborNodeState(neighIP, 0); // Set node as ordinary
+              m_table->SetNeighborNodeState(neighIP, 0); // Set node as ordinary
               cout << m_nodeIP << " : " << timeNow 
                    << " FlySafePacketSink - Turned node " << neighIP << " honest!" << endl;
               NotifyNeighbors(neighIP, position, 0, 6); // Nofity about Suspicious reduction to honest
@@ -307,16 +353,16 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
               // Ordinary operation - switch
           }
       else if (distance > 115) { // Honest neighbor send a false location
-          if(!ThisNode->IsAlreadyNeighbor(neighIP)) { // Register node in NL
-            ThisNode->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);
+          if(!m_table->IsAlreadyNeighbor(neighIP)) { // Register node in NL
+            m_table->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);
             cout << m_nodeIP << " : " << timeNow 
                << " FlySafePacketSink - Register node " << neighIP << " as a neighbor!" << endl; 
             suspiciousRegistered = true;
           }
           cout << m_nodeIP << " : " << timeNow 
                << " FlySafePacketSink - Turn node " << neighIP << " suspicious!" << endl;
-          ThisNode->RegisterMaliciousNode(neighIP, m_nodeIP); // Insert node in SL
-          ThisNode->SetNeighborNodeState(neighIP, 1); // Set node as suspect
+          m_table->RegisterMaliciousNode(neighIP, m_nodeIP); // Insert node in SL
+          m_table->SetNeighborNodeState(neighIP, 1); // Set node as suspect
           PrintMyNeighborList();
           NotifyNeighbors(neighIP, position, 1, 4); // Notify neighbors
           // Ordinary operation - switch
@@ -344,7 +390,7 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
                << " - " << receivedTag.GetNNeighbors() << " neighbor(s) - " 
                << " At " << distance << " meters and sent at " << receivedTag.GetMessageTime() << "s" << std::endl;
           
-          if((int)ThisNode->GetState() == 1){ // Node will be malcious?
+          if((int)m_table->GetState() == 1){ // Node will be malcious?
             if (timeNow >= m_maliciousTime){ // Time to become malicious
               //cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Turn to malicious operation!" << endl;
               if (!m_maliciousRegister){
@@ -359,7 +405,7 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             }
           }
 
-          SendMessage(neighIPPort,"hello!",1, (uint32_t) nNeigh, nodePosition, nodeInfosVectorTag); // Sent identification
+          SendMessage(neighIPPort,1, (uint32_t) nNeigh, nodePosition); // Sent identification
           
           neighListFull = GetNeighborIpListFull();
           m_txTrace(timeNow, m_nodeIP,neighIP,1,"Identification", position, neighListFull); // Callback for id message sent
@@ -370,17 +416,17 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                  << " in my neighbors list" << std::endl;
           }
-          else if (ThisNode->IsAlreadyNeighbor(neighIP)) { // Check if neighbor node is in neighbors list
+          else if (m_table->IsAlreadyNeighbor(neighIP)) { // Check if neighbor node is in neighbors list
               
               cout << m_nodeIP << " : " << timeNow << " " << neighIP << " is already my neighbor!" << std::endl;
               cout << m_nodeIP << " : " << timeNow << " Updated " << neighIP <<  " position!" << std::endl;
               
-              ThisNode->UpdateNeighbor(neighIP, position, distance, neighAttitude, 3, 1);  
+              m_table->UpdateNeighbor(neighIP, position, distance, neighAttitude, 3, 1);  
           }
           else { // Put neighbor node in my neighbors list
               cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                    << " in my neighbors list" << std::endl;
-              ThisNode->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);    
+              m_table->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);    
           }
           
           if(numberNNeighbors != 0){
@@ -408,13 +454,13 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                  << " in my neighbors list" << std::endl;
           }
-          else if (ThisNode->IsAlreadyNeighbor(neighIP)){
-            ThisNode->UpdateNeighbor(neighIP,position, distance, neighAttitude, 3, 1);
+          else if (m_table->IsAlreadyNeighbor(neighIP)){
+            m_table->UpdateNeighbor(neighIP,position, distance, neighAttitude, 3, 1);
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Updated " << neighIP 
                  << " in my neighbors list" << std::endl;
           }
           else {
-            ThisNode->RegisterNeighbor(neighIP,position,distance,neighAttitude,3, 1, 0);
+            m_table->RegisterNeighbor(neighIP,position,distance,neighAttitude,3, 1, 0);
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                 << " in my neighbors list" << std::endl;
           }
@@ -442,7 +488,13 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
           cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Neighborhood before update NL with this trap message!" << endl;
           PrintMyNeighborList(); 
 
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - NL received with this trap message from " << neighIP << endl;
+          if (receivedTag.IsDeltaList()){ // Only the entries changed since the previous trap
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - NL changes received with this trap message from " << neighIP 
+                 << ": " << neighInfosVectorTag.size() << " of " << numberNNeighbors << " neighbors" << endl;
+          }
+          else {
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - NL received with this trap message from " << neighIP << endl;
+          }
           PrintNeighborList(neighInfosVectorTag);
           
           if (suspiciousRegistered){ // Registered in malicious nodes analysis
@@ -450,18 +502,18 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                  << " in my neighbors list" << std::endl;
           }
-          else if (!ThisNode->IsAlreadyNeighbor(neighIP)){
-            ThisNode->RegisterNeighbor(neighIP,position,distance,neighAttitude,3,1, 0);
+          else if (!m_table->IsAlreadyNeighbor(neighIP)){
+            m_table->RegisterNeighbor(neighIP,position,distance,neighAttitude,3,1, 0);
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                  << " in my neighbors list" << std::endl;
           }
           else {
-            ThisNode->UpdateNeighbor(neighIP,position, distance, neighAttitude, 3, 1);
+            m_table->UpdateNeighbor(neighIP,position, distance, neighAttitude, 3, 1);
             cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Updated " << neighIP 
                  << " location in my neighbors list" << std::endl; 
           }
 
-          if(numberNNeighbors != 0){
+          if(!neighInfosVectorTag.empty()){ // A delta NL may carry no changes
             UpdateMyNeighborList(neighInfosVectorTag);
           }
 
@@ -483,7 +535,7 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
                 << " - " << receivedTag.GetNNeighbors() << " neighbor(s) - " 
                 << " At " << distance << " meters and sent at " << receivedTag.GetMessageTime() << "s" << std::endl;
 
-          if((int)ThisNode->GetState() == 1){ // Node will be malcious?
+          if((int)m_table->GetState() == 1){ // Node will be malcious?
             if (timeNow >= m_maliciousTime){ // Time to becom malicious
               if (!m_maliciousRegister){
                 cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Turn to malicious operation!" << endl;
@@ -497,7 +549,7 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
             }
           }
 
-          SendMessage(neighIPPort,"hello!",1, (uint32_t) nNeigh, nodePosition, nodeInfosVectorTag); // Sent identification
+          SendMessage(neighIPPort,1, (uint32_t) nNeigh, nodePosition); // Sent identification
 
           if (suspiciousRegistered){ // Registered in malicious nodes analysis
             suspiciousRegistered = false;
@@ -505,17 +557,17 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
                  << " in my neighbors list" << std::endl;
           }
           // Update my neighbor list with new neighbor broadcasted information 
-          else if (ThisNode->IsAlreadyNeighbor(neighIP)) { // Check if neighbor node is in neighbors list
+          else if (m_table->IsAlreadyNeighbor(neighIP)) { // Check if neighbor node is in neighbors list
               
               cout << m_nodeIP << " : " << timeNow << " " << neighIP << " is already my neighbor!" << std::endl;
               cout << m_nodeIP << " : " << timeNow << " Updated " << neighIP <<  " position!" << std::endl;
               
-              ThisNode->UpdateNeighbor(neighIP, position, distance, neighAttitude, 3, 1); 
+              m_table->UpdateNeighbor(neighIP, position, distance, neighAttitude, 3, 1); 
           }
           else { // Put neighbor node in my neighbors list
               cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Registered " << neighIP 
                     << " in my neighbors list" << std::endl;
-              ThisNode->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);    
+              m_table->RegisterNeighbor(neighIP, position, distance, 0, 3, 1, 0);    
           }
           
           if(numberNNeighbors != 0){
@@ -533,35 +585,37 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
       
       case 4: // Message about a suspect neighbor
         {
-        cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Received a message from " << neighIP 
-             << " about a suspect node (Tag 4): " <<  neighInfosVectorTag[0].ip << std::endl;
         PrintNeighborList(neighInfosVectorTag);
-        PrintMyNeighborList();
-        PrintMySupiciousList();
-        if (ThisNode->IsAMaliciousNode(neighInfosVectorTag[0].ip)){
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Increase malicious node " << neighInfosVectorTag[0].ip << " recurrence (Tag 4)!" << std::endl;
-          ThisNode->IncreaseMaliciousNodeRecurrence(neighInfosVectorTag[0].ip, neighIP);
-          if (ThisNode->GetMaliciousNodeRecurrence(neighInfosVectorTag[0].ip) == 3){
-            ThisNode->SetMaliciousNodeState(neighInfosVectorTag[0].ip,1); // Block a suspect node in SL
-            ThisNode->UnregisterNeighbor(neighInfosVectorTag[0].ip); // Remove blocked node from NL
-            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Remove and block a malicious node " << neighInfosVectorTag[0].ip << " (Tag 4)!" << std::endl;
-          }
-        }
-        else{ // Node not malicious yet!!!
-          if (ThisNode->IsAlreadyNeighbor(neighInfosVectorTag[0].ip)){
-            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Set node " << neighInfosVectorTag[0].ip << " as suspect (Tag 4)!" << std::endl;
-            ThisNode->SetNeighborNodeState(neighInfosVectorTag[0].ip,1); // Set node as malicious in NL
+        for (const auto &alert : neighInfosVectorTag) { // Alerts may carry several suspects - Feb 22, 24
+          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Received a message from " << neighIP 
+               << " about a suspect node (Tag 4): " <<  alert.ip << std::endl;
+          PrintMyNeighborList();
+          PrintMySupiciousList();
+          if (m_table->IsAMaliciousNode(alert.ip)){
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Increase malicious node " << alert.ip << " recurrence (Tag 4)!" << std::endl;
+            m_table->IncreaseMaliciousNodeRecurrence(alert.ip, neighIP);
+            if (m_table->GetMaliciousNodeRecurrence(alert.ip) == 3){
+              m_table->SetMaliciousNodeState(alert.ip,1); // Block a suspect node in SL
+              m_table->UnregisterNeighbor(alert.ip); // Remove blocked node from NL
+              cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Remove and block a malicious node " << alert.ip << " (Tag 4)!" << std::endl;
+            }
           }
-          else{
-            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Register suspect node " << neighInfosVectorTag[0].ip << " in NL (Tag 4)!" << std::endl;
-            position.x = neighInfosVectorTag[0].x;
-            position.y = neighInfosVectorTag[0].y;
-            position.z = neighInfosVectorTag[0].z;
-            distance = CalculateNodesDistance(nodePosition, position); // Calculate distance between nodes
-            ThisNode->RegisterNeighbor(neighInfosVectorTag[0].ip, position, distance, 0, 3, neighInfosVectorTag[0].hop +1, 1); // Register node as malicious
+          else{ // Node not malicious yet!!!
+            if (m_table->IsAlreadyNeighbor(alert.ip)){
+              cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Set node " << alert.ip << " as suspect (Tag 4)!" << std::endl;
+              m_table->SetNeighborNodeState(alert.ip,1); // Set node as malicious in NL
+            }
+            else{
+              cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Register suspect node " << alert.ip << " in NL (Tag 4)!" << std::endl;
+              position.x = alert.x;
+              position.y = alert.y;
+              position.z = alert.z;
+              distance = CalculateNodesDistance(nodePosition, position); // Calculate distance between nodes
+              m_table->RegisterNeighbor(alert.ip, position, distance, 0, 3, alert.hop +1, 1); // Register node as malicious
+            }
+            m_table->RegisterMaliciousNode(alert.ip, m_nodeIP); // Register a malicious node in SL
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Set node " << alert.ip << " as malicious in SL (Tag 4)!" << std::endl;
           }
-          ThisNode->RegisterMaliciousNode(neighInfosVectorTag[0].ip, m_nodeIP); // Register a malicious node in SL
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Set node " << neighInfosVectorTag[0].ip << " as malicious in SL (Tag 4)!" << std::endl;
         }
 
         neighListFull = GetNeighborIpListFull();
@@ -576,25 +630,27 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
 
       case 5: // Message about a blocked neighbor (Nov 09, 23)
         {
-        cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Received a message from " << neighIP 
-             << " about a blocked node (Tag 5): " <<  neighInfosVectorTag[0].ip << std::endl;
         PrintNeighborList(neighInfosVectorTag);
-        PrintMyNeighborList();
-        PrintMySupiciousList();
-        if (ThisNode->IsAlreadyNeighbor(neighInfosVectorTag[0].ip)){ // Remove blocked node from NL
-          ThisNode->UnregisterNeighbor(neighInfosVectorTag[0].ip);
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Removed blocked node " << neighInfosVectorTag[0].ip << " from NL (Tag 5)!" << std::endl;
-        }
-        if (!ThisNode->IsAMaliciousNode(neighInfosVectorTag[0].ip)){ // Register malicious node in SL
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Register blocked node " << neighInfosVectorTag[0].ip << " in SL (Tag 5)!" << std::endl;
-          ThisNode->RegisterMaliciousNode(neighInfosVectorTag[0].ip, neighIP);
-          ThisNode->SetMaliciousNodeState(neighInfosVectorTag[0].ip,1); // Block a malicious node in SL
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Blocked malicious node " << neighInfosVectorTag[0].ip << " in SL (Tag 5)!\n" << std::endl;
-        } 
-        else {
-          ThisNode->IncreaseMaliciousNodeRecurrence(neighInfosVectorTag[0].ip, neighIP);
-          ThisNode->SetMaliciousNodeState(neighInfosVectorTag[0].ip,1); // Block a malicious node in SL
-          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Blocked malicious node " << neighInfosVectorTag[0].ip << " in SL (Tag 5)!\n" << std::endl;
+        for (const auto &alert : neighInfosVectorTag) { // Alerts may carry several suspects - Feb 22, 24
+          cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Received a message from " << neighIP 
+               << " about a blocked node (Tag 5): " <<  alert.ip << std::endl;
+          PrintMyNeighborList();
+          PrintMySupiciousList();
+          if (m_table->IsAlreadyNeighbor(alert.ip)){ // Remove blocked node from NL
+            m_table->UnregisterNeighbor(alert.ip);
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Removed blocked node " << alert.ip << " from NL (Tag 5)!" << std::endl;
+          }
+          if (!m_table->IsAMaliciousNode(alert.ip)){ // Register malicious node in SL
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Register blocked node " << alert.ip << " in SL (Tag 5)!" << std::endl;
+            m_table->RegisterMaliciousNode(alert.ip, neighIP);
+            m_table->SetMaliciousNodeState(alert.ip,1); // Block a malicious node in SL
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Blocked malicious node " << alert.ip << " in SL (Tag 5)!\n" << std::endl;
+          } 
+          else {
+            m_table->IncreaseMaliciousNodeRecurrence(alert.ip, neighIP);
+            m_table->SetMaliciousNodeState(alert.ip,1); // Block a malicious node in SL
+            cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Blocked malicious node " << alert.ip << " in SL (Tag 5)!\n" << std::endl;
+          }
         }
 
         neighListFull = GetNeighborIpListFull();
@@ -610,24 +666,26 @@ void FlySafePacketSink::PacketReceived(Ptr<Socket> socket) {
       case 6: // Message about reducing suspect level about a neighbor node (Nov 20, 23)
               // Decreased neighbor recurrence after receiving a true location information
         {
-        cout << m_nodeIP << " : " << timeNow 
-             << " FlySafePacketSink - Received a notification from " << neighIP 
-             << " about reducing suspect level of node " << neighInfosVectorTag[0].ip << " (Tag 6)!" << endl;
-        PrintMyNeighborList();
-        PrintMySupiciousList();
-        if (ThisNode->IsAMaliciousNode(neighInfosVectorTag[0].ip)){
-          ThisNode->DecreaseMaliciousNodeRecurrence(neighInfosVectorTag[0].ip, neighIP);
-          if (ThisNode->GetMaliciousNodeRecurrence(neighInfosVectorTag[0].ip) == 0){ // Nodes became honest
-              ThisNode->UnregisterMaliciousNode(neighInfosVectorTag[0].ip);
-              cout << m_nodeIP << " : " << timeNow 
-                  << " FlySafePacketSink - Removed node " << neighInfosVectorTag[0].ip << " from SL!" << endl;
-              ThisNode->SetNeighborNodeState(neighInfosVectorTag[0].ip, 0); // Set node as ordinary
-              cout << m_nodeIP << " : " << timeNow 
-                  << " FlySafePacketSink - Turned node " << neighInfosVectorTag[0].ip << " honest!" << endl; 
-            }           
-          }
-        PrintMySupiciousList();
-        PrintMyNeighborList(); 
+        for (const auto &alert : neighInfosVectorTag) { // Alerts may carry several suspects - Feb 22, 24
+          cout << m_nodeIP << " : " << timeNow 
+               << " FlySafePacketSink - Received a notification from " << neighIP 
+               << " about reducing suspect level of node " << alert.ip << " (Tag 6)!" << endl;
+          PrintMyNeighborList();
+          PrintMySupiciousList();
+          if (m_table->IsAMaliciousNode(alert.ip)){
+            m_table->DecreaseMaliciousNodeRecurrence(alert.ip, neighIP);
+            if (m_table->GetMaliciousNodeRecurrence(alert.ip) == 0){ // Nodes became honest
+                m_table->UnregisterMaliciousNode(alert.ip);
+                cout << m_nodeIP << " : " << timeNow 
+                    << " FlySafePacketSink - Removed node " << alert.ip << " from SL!" << endl;
+                m_table->SetNeighborNodeState(alert.ip, 0); // Set node as ordinary
+                cout << m_nodeIP << " : " << timeNow 
+                    << " FlySafePacketSink - Turned node " << alert.ip << " honest!" << endl; 
+              }           
+            }
+          PrintMySupiciousList();
+          PrintMyNeighborList(); 
+        }
 
         neighListFull = GetNeighborIpListFull();
         m_sinkTrace(timeNow, nodePosition, m_nodeIP, neighIP, 6, "Suspection reduction", 
@@ -671,52 +729,130 @@ void FlySafePacketSink::ManipulateAccept(Ptr<Socket> s, const Address &neighAdd)
 /**
  * @brief Send a message to a neighbor node
  * @date 2022
+ * @date Feb 22, 2024 - NL loaded in m_txTag by LoadNeighInfos
  * 
  * @param addressTo Neighbor node address (IPv4 + port)
- * @param message Message (string)
  * @param tagValue Tag value (0, 1, 2, 3, 4 or 5)
  * @param nNeigbors Number of neighbor nodes from the source node
  * @param nodePosition Source node position
  */
-void FlySafePacketSink::SendMessage(Address addressTo, string message,
-                                   uint8_t tagValue, u_int32_t nNeigbors, Vector nodePosition,
-                                   std::vector<ns3::MyTag::NeighInfos> nodeInfos) {
+void FlySafePacketSink::SendMessage(Address addressTo, uint8_t tagValue, 
+                                   u_int32_t nNeigbors, Vector nodePosition) {
 
   double timeNow;
 
   Ipv4Address destinyIP = InetSocketAddress::ConvertFrom(addressTo).GetIpv4();
 
-  Address destinyAddress(InetSocketAddress(
-      Ipv4Address(InetSocketAddress::ConvertFrom(addressTo).GetIpv4()), 9));  // Add port 9 to destiny address
-  Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
-
-  if (socket->Bind() == -1) {
-    NS_FATAL_ERROR("Failed to bind socket");
-  }
-
-  socket->Connect(destinyAddress);
-  Ptr<Packet> packet;
-
-  packet = Create<Packet>(reinterpret_cast<const uint8_t *>(message.c_str()),
-                          message.size());
-  MyTag tagToSend;
-  tagToSend.SetSimpleValue(tagValue);         // Add tag value
-  tagToSend.SetNNeighbors(nNeigbors);         // Add the number of neighbor nodes to tag
-  tagToSend.SetPosition(nodePosition);        // Add nodes positin to tag
-  tagToSend.SetNeighInfosVector(nodeInfos);   // Add nodes NL to tag
+  m_txTag.SetSimpleValue(tagValue);         // Add tag value
+  m_txTag.SetNNeighbors(nNeigbors);         // Add the number of neighbor nodes to tag
+  m_txTag.SetPosition(nodePosition);        // Add nodes positin to tag
 
   timeNow = Simulator::Now().GetSeconds();
-  tagToSend.SetMessageTime(timeNow);
+  m_txTag.SetMessageTime(timeNow);
 
   cout << m_nodeIP << " : " << timeNow << " FlySafePacketSink - Sent Identification to "
       << destinyIP << " from position x: " << nodePosition.x << " y: " << nodePosition.y << " z: " << nodePosition.z 
-      << " - " << tagToSend.GetNNeighbors() << " neighbor(s)" << std::endl;
+      << " - " << m_txTag.GetNNeighbors() << " neighbor(s)" << std::endl;
   
   PrintMyNeighborList();
 
-  packet->AddPacketTag(tagToSend);
-  socket->Send(packet);
-  socket->Close();
+  SendMessageCopy(destinyIP, CreateMessage(m_txTag));
+}
+
+/**
+ * @brief Load node NL into a tag, reusing the tag NL storage
+ * @date Feb 22, 2024
+ * 
+ * @param tag Tag to receive the NL
+ */
+void FlySafePacketSink::LoadNeighInfos(MyTag &tag) {
+  std::vector<ns3::MyTag::NeighInfos> nodeInfos = tag.TakeNeighInfosVector();
+  ns3::MyTag::NeighInfos nodeInfo;
+
+  int nNeighbors = m_table->GetNNeighbors();
+  nodeInfos.clear(); // Keeps the capacity of the previous messages
+  nodeInfos.reserve(nNeighbors);
+
+  for (int i = 0; i < nNeighbors; i++) {
+    FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+    nodeInfo.ip = neighbor.ip;
+    nodeInfo.x = neighbor.position.x;
+    nodeInfo.y = neighbor.position.y;
+    nodeInfo.z = neighbor.position.z;
+    nodeInfo.hop = neighbor.hop;
+    nodeInfo.state = neighbor.state;
+    nodeInfo.infoTime = neighbor.infoTime;
+    nodeInfos.push_back(nodeInfo);
+  }
+  tag.SetNeighInfosVector(std::move(nodeInfos));
+}
+
+/**
+ * @brief Create a message with a fixed size payload and a FlySafe tag
+ * @date Feb 22, 2024
+ * 
+ * @param tag Tag with the message data
+ * @return Ptr<Packet> Message to send, or to copy for each destination
+ */
+Ptr<Packet> FlySafePacketSink::CreateMessage(MyTag &tag) {
+  // Zero filled payload, the header is the payload with the header transport
+  Ptr<Packet> packet = Create<Packet>(m_transport == FlySafeHeader::TRANSPORT_HEADER ? 0 : m_payloadSize);
+  AddMessageTag(packet, tag);
+  return packet;
+}
+
+/**
+ * @brief Send a copy of a message to a neighbor node
+ * @date Feb 22, 2024
+ * @date Feb 24, 2024 - UDP messages share one socket
+ * 
+ * @param addressTo Neighbor node IPv4 address
+ * @param message Message created by CreateMessage
+ */
+void FlySafePacketSink::SendMessageCopy(Ipv4Address addressTo, Ptr<const Packet> message) {
+  Address destinyAddress(InetSocketAddress(addressTo, 9));  // Add port 9 to destiny address
+
+  if (m_tid != UdpSocketFactory::GetTypeId()) { // Connection oriented, one socket per message
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+
+    if (socket->Bind() == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+
+    socket->Connect(destinyAddress);
+    socket->Send(message->Copy()); // Copy on write, shares payload and tags
+    socket->Close();
+    return;
+  }
+
+  if (!m_unicastSocket) { // One bound socket sends every unicast - Feb 24, 24
+    m_unicastSocket = Socket::CreateSocket(GetNode(), m_tid);
+
+    if (m_unicastSocket->Bind() == -1) {
+      NS_FATAL_ERROR("Failed to bind socket");
+    }
+  }
+  m_unicastSocket->SendTo(message->Copy(), 0, destinyAddress); // Copy on write, shares payload and tags
+}
+
+/**
+ * @brief Add a FlySafe tag to a packet, with the configured position encoding
+ * @date Feb 19, 2024
+ * @date Feb 23, 2024 - As a FlySafeHeader with the header transport
+ * 
+ * @param packet Packet to send
+ * @param tag Tag with the message data
+ */
+void FlySafePacketSink::AddMessageTag(Ptr<Packet> packet, MyTag &tag) {
+  tag.SetPositionEncoding(m_positionEncoding);
+  if (m_positionEncoding != MyTag::POSITION_DOUBLE || tag.IsAlertList()) { // Alerts are always quantized
+    m_quantizationTrace(Simulator::Now().GetSeconds(), m_nodeIP, tag.GetQuantizationError());
+  }
+  if (m_transport == FlySafeHeader::TRANSPORT_HEADER) {
+    packet->AddHeader(FlySafeHeader(tag)); // Real bytes, sent on air - Feb 23, 24
+  } else {
+    packet->AddPacketTag(tag);
+  }
 }
 
 /**
@@ -759,25 +895,21 @@ Vector FlySafePacketSink::GetNodeActualPosition()
  */
 
 void FlySafePacketSink::PrintMyNeighborList() {
-  Vector position;
-  std::vector<ns3::Ipv4Address> neighborList;
-
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
+  int nNeighbors = m_table->GetNNeighbors();
 
   cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
        << " FlySafePacketSink - My neighbors are: " 
-       << ThisNode->GetNNeighbors() << endl;
-
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    position = ThisNode->GetNeighborPosition(neighborList[i]);
-    cout << neighborList[i] << " : Position x: " 
-         << position.x << " y: " << position.y << " z: " << position.z 
-         << " Distance: " << ThisNode->GetNeighborDistance(neighborList[i]) 
-         << "m Attitude: " << (int)ThisNode->GetNeighborAttitude(neighborList[i])
-         << " Quality: " << (int)ThisNode->GetNeighborQuality(neighborList[i]) 
-         << " Hop: " << (int)ThisNode->GetNeighborHop(neighborList[i])
-         << " State: " << (int)ThisNode->GetNeighborNodeState(neighborList[i]) << endl;
+       << nNeighbors << endl;
+
+  for (int i = 0; i < nNeighbors; i++) {
+    FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+    cout << neighbor.ip << " : Position x: " 
+         << neighbor.position.x << " y: " << neighbor.position.y << " z: " << neighbor.position.z 
+         << " Distance: " << neighbor.distance 
+         << "m Attitude: " << (int)neighbor.attitude
+         << " Quality: " << (int)neighbor.quality 
+         << " Hop: " << (int)neighbor.hop
+         << " State: " << (int)neighbor.state << endl;
   }
   cout << "\n" << endl;
 }
@@ -789,22 +921,17 @@ void FlySafePacketSink::PrintMyNeighborList() {
  */
 
 void FlySafePacketSink::PrintMySupiciousList() {
-  std::vector<ns3::Ipv4Address> suspiciousList;
-  std::vector<ns3::Ipv4Address> notifiers;
-
-  Ptr<Node> ThisNode = this->GetNode();
-  suspiciousList = ThisNode->GetMaliciousNodeIpList();
+  Ipv4AddressRange suspiciousList = m_table->GetMaliciousNodeIps(); // No copy - Jan 30, 24
 
   cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
        << " FlySafePacketSink - My suspicious neighbors are: " 
-       << (int)ThisNode->GetNMaliciousNodes() << endl;
-
-  for (uint8_t i = 0; i < suspiciousList.size(); i++) {
-    notifiers = ThisNode->GetMaliciousNodesIPNotifiers(suspiciousList[i]);
-    cout << suspiciousList[i] 
-         << " State: " << (int)ThisNode->GetMaliciousNodeState(suspiciousList[i])
-         << " Recurrence: " << (int)ThisNode->GetMaliciousNodeRecurrence(suspiciousList[i])
-         << " Notifiers: " << convertIPVectorToString(notifiers) << endl;
+       << (int)m_table->GetNMaliciousNodes() << endl;
+
+  for (const Ipv4Address &suspicious : suspiciousList) {
+    cout << suspicious 
+         << " State: " << (int)m_table->GetMaliciousNodeState(suspicious)
+         << " Recurrence: " << (int)m_table->GetMaliciousNodeRecurrence(suspicious)
+         << " Notifiers: " << convertIPVectorToString(m_table->GetMaliciousNodeNotifiers(suspicious)) << endl;
   }
   cout << "\n" << endl;
 }
@@ -815,61 +942,27 @@ void FlySafePacketSink::PrintMySupiciousList() {
  * 
  * @param neighInfos neighbors infomaation
  */
-void FlySafePacketSink::UpdateMyNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos){
-  Ptr<Node> ThisNode = this->GetNode();
-  Vector nodePosition;
-  Vector neighPosition;
-  double distance, value;
-  uint8_t neighAttitude;
-  uint8_t hop;
-  //uint8_t state;
-
-  nodePosition = GetNodeActualPosition();
+void FlySafePacketSink::UpdateMyNeighborList(const std::vector<ns3::MyTag::NeighInfos> &neighInfos){
+  std::vector<FlySafeNeighborTable::Neighbor> entries;
+  FlySafeNeighborTable::Neighbor entry;
+  uint32_t merged;
+
+  entries.reserve(neighInfos.size());
+  for(const auto &n :neighInfos){
+    entry.ip = n.ip;
+    entry.position = Vector(n.x, n.y, n.z);
+    entry.hop = n.hop;
+    entry.state = n.state;
+    entry.infoTime = n.infoTime;
+    entries.push_back(entry);
+  }
 
-  for(auto n :neighInfos){
-    if(n.ip != m_nodeIP || ThisNode->IsABlockedNode(n.ip)){ // Avoid register in NL the node itself or a blocked node
-      
-      neighPosition.x = n.x;
-      neighPosition.y = n.y;
-      neighPosition.z = n.z;
-      hop = n.hop;
-      //state = n.state;
+  // The node itself and blocked nodes are not registered in NL
+  merged = m_table->MergeNeighborList(std::move(entries), GetNodeActualPosition(), m_nodeIP);
 
-      value = CalculateDistance(nodePosition, neighPosition);
-      distance = std::ceil(value * 100.0) / 100.0; // 2 decimal cases
-      
-      // Neighbors from neighbors are registered with quality 1 to
-      // reduce their permance in the NL
-      
-      if(ThisNode->IsAlreadyNeighbor(n.ip)){
-        // Update only if positions are diferents
-        if(isPositionChanged(ThisNode->GetNeighborPosition(n.ip), neighPosition)){
-          // check attitude
-          neighAttitude = CheckNeighAttitude(distance,ThisNode->GetNeighborDistance(n.ip));
-          // update neighbor list
-          ThisNode->UpdateNeighbor(n.ip, neighPosition, distance, neighAttitude,1, 
-                                   std::min((hop + 1), (int)ThisNode->GetNeighborHop(n.ip)));
-          std::cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
-            << " FlySafePacketSink - Updated neighbor " << n.ip 
-            << " infomation. Choose hop " << (int)std::min(hop + 1, (int)ThisNode->GetNeighborHop(n.ip)) 
-            << " from new one " << (int)hop + 1 << " and registered " 
-            << (int)ThisNode->GetNeighborHop(n.ip) << std::endl; 
-        }
-        else{ // Neighbor node is stopped
-          ThisNode->SetNeighborHop(n.ip, std::min((hop + 1), (int)ThisNode->GetNeighborHop(n.ip)));
-          std::cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
-            << " FlySafePacketSink - Updated neighbor " << n.ip 
-            << " hop to " << (int)std::min(hop + 1, (int)ThisNode->GetNeighborHop(n.ip)) 
-            << " from new one " << (int)hop + 1 << " and registered " 
-            << (int)ThisNode->GetNeighborHop(n.ip) << std::endl;          
-        }
-      }
-      else {
-        // register new node in the list with the received hop plus 1
-        ThisNode->RegisterNeighbor(n.ip, neighPosition, distance, 0, 1, hop + 1, 0);
-      }
-    }
-  }
+  std::cout << m_nodeIP << " : " << Simulator::Now().GetSeconds() 
+            << " FlySafePacketSink - Merged " << merged << " of " << neighInfos.size() 
+            << " received NL entries in my NL" << std::endl;
 }
 
 
@@ -898,37 +991,6 @@ uint8_t FlySafePacketSink::CheckNeighAttitude(double newDistance, double oldDist
   return neighAttitude;
 }
 
-/**
- * @brief Create a vector from node neigbor list
- * @date Feb 22, 2023
- * 
- * @param neighborList Vector with neighbor list Ipv4 Adress
- */
-std::vector<FlySafePacketSink::NeighInfos> FlySafePacketSink::GetNeighborListVector(){
-  vector<Ipv4Address> neighborList;
-  std::vector<FlySafePacketSink::NeighInfos> neighborListVector;
-  Vector position;
-  FlySafePacketSink::NeighInfos node;
-
-  neighborListVector.clear();
-  
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-  
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    position = ThisNode->GetNeighborPosition(neighborList[i]);
-		node.ip = neighborList[i];
-		node.x = position.x;
-		node.y = position.y;
-		node.z = position.z;
-    node.hop = ThisNode->GetNeighborHop(neighborList[i]);
-    node.state = ThisNode->GetNeighborNodeState(neighborList[i]);
-		neighborListVector.push_back(node);
-  }  
-
-  return neighborListVector;
-}
-
 /**
  * @brief Put neighbors information in a string
  * @date Mar 28, 2023
@@ -937,22 +999,19 @@ std::vector<FlySafePacketSink::NeighInfos> FlySafePacketSink::GetNeighborListVec
  */
 ostringstream FlySafePacketSink::neighListToString() { 
   ostringstream neighString;
-  vector<Ipv4Address> neighborList;
-  Vector position;
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-
-  neighString << (int)neighborList.size();
-
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    position = ThisNode->GetNeighborPosition(neighborList[i]);
-    neighString << "\t" << neighborList[i] 
-                << "," << position.x << "," << position.y << "," << position.z
-                << "," << ThisNode->GetNeighborDistance(neighborList[i])
-                << "," << (int)ThisNode->GetNeighborAttitude(neighborList[i])
-                << "," << (int)ThisNode->GetNeighborQuality(neighborList[i])
-                << "," << (int)ThisNode->GetNeighborHop(neighborList[i])
-                << "," << (int)ThisNode->GetNeighborNodeState(neighborList[i]);
+  int nNeighbors = m_table->GetNNeighbors();
+
+  neighString << nNeighbors;
+
+  for (int i = 0; i < nNeighbors; i++) {
+    FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+    neighString << "\t" << neighbor.ip 
+                << "," << neighbor.position.x << "," << neighbor.position.y << "," << neighbor.position.z
+                << "," << neighbor.distance
+                << "," << (int)neighbor.attitude
+                << "," << (int)neighbor.quality
+                << "," << (int)neighbor.hop
+                << "," << (int)neighbor.state;
   }
   neighString << endl;  
   return neighString;
@@ -962,28 +1021,10 @@ ostringstream FlySafePacketSink::neighListToString() {
  * @brief Get the Neighbor Ip List Full object
  * @date Apr 7, 2023
  * 
- * @return vector<ns3::MyTag::NeighborFull> 
+ * @return Ptr<const NeighborSnapshot> - Shared, immutable copy of the NL
  */
-vector<ns3::MyTag::NeighborFull> FlySafePacketSink::GetNeighborIpListFull() { 
-  vector<Ipv4Address> neighborList;
-  vector<ns3::MyTag::NeighborFull> neighListFull;
-  ns3::MyTag::NeighborFull NeighInfo;
-  Vector position;
-
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList();
-
-  for (uint8_t i = 0; i < neighborList.size(); i++) {
-    NeighInfo.ip = neighborList[i];
-    NeighInfo.position = ThisNode->GetNeighborPosition(neighborList[i]);
-    NeighInfo.distance = ThisNode->GetNeighborDistance(neighborList[i]);
-    NeighInfo.hop = ThisNode->GetNeighborHop(neighborList[i]);
-    NeighInfo.state = ThisNode->GetNeighborNodeState(neighborList[i]);
-    NeighInfo.attitude = ThisNode->GetNeighborAttitude(neighborList[i]);
-    NeighInfo.quality = ThisNode->GetNeighborQuality(neighborList[i]);
-    neighListFull.push_back(NeighInfo);
-  }
-  return neighListFull;
+Ptr<const NeighborSnapshot> FlySafePacketSink::GetNeighborIpListFull() { 
+  return m_table->GetNeighborSnapshot(); // Rebuilt only when the NL changed - Feb 1, 24
 }
 
 
@@ -994,21 +1035,17 @@ vector<ns3::MyTag::NeighborFull> FlySafePacketSink::GetNeighborIpListFull() {
  * @return vector<ns3::MyTag::MaliciousNode> 
  */
 vector<ns3::MyTag::MaliciousNode> FlySafePacketSink::GetMaliciousNeighborList() { 
-  vector<Ipv4Address> maliciousIPList;
-  //vector<Ipv4Address> notifiersIP;
   vector<ns3::MyTag::MaliciousNode> maliciousListFull;
   ns3::MyTag::MaliciousNode maliciousInfo;
-  Vector position;
 
-  Ptr<Node> ThisNode = this->GetNode();
-  maliciousIPList = ThisNode->GetMaliciousNodeIpList();
-
-  for (uint8_t i = 0; i < maliciousIPList.size(); i++) {
-    maliciousInfo.ip = maliciousIPList[i];
-    maliciousInfo.state = ThisNode->GetMaliciousNodeState(maliciousIPList[i]);
-    maliciousInfo.recurrence = ThisNode->GetMaliciousNodeRecurrence(maliciousIPList[i]);
-    //notifiersIP = ThisNode->GetMaliciousNodesIPNotifiers(maliciousIPList[i]);
-    maliciousInfo.notifyIP = ThisNode->GetMaliciousNodesIPNotifiers(maliciousIPList[i]);
+  Ipv4AddressRange maliciousIPList = m_table->GetMaliciousNodeIps();
+  maliciousListFull.reserve(maliciousIPList.size());
+
+  for (const Ipv4Address &maliciousIP : maliciousIPList) {
+    maliciousInfo.ip = maliciousIP;
+    maliciousInfo.state = m_table->GetMaliciousNodeState(maliciousIP);
+    maliciousInfo.recurrence = m_table->GetMaliciousNodeRecurrence(maliciousIP);
+    maliciousInfo.notifyIP = m_table->GetMaliciousNodeNotifiers(maliciousIP).ToVector();
     maliciousListFull.push_back(maliciousInfo);
   }
   return maliciousListFull;
@@ -1018,90 +1055,126 @@ vector<ns3::MyTag::MaliciousNode> FlySafePacketSink::GetMaliciousNeighborList()
 
 /**
  * @brief Notify neighbor nodes (one hop away and non malicious) about a malicious node
+ * @date Feb 22, 2024 - Queued, the alerts of a round are sent together
  * 
  * @param maliciousIP - malicious node IP address
  * @param tagValue - 0 (suspect) or 1 (blocked)
  */
 void FlySafePacketSink::NotifyNeighbors(Ipv4Address maliciousIP, Vector position, uint8_t state, uint8_t tagValue){
   
-  vector<Ipv4Address> neighborList;
-  double timeNow;
-  string textLog;
-  string message;
-
-  Vector nPosition = GetNodeActualPosition();
-
-  Ptr<Node> ThisNode = this->GetNode();
-  neighborList = ThisNode->GetNeighborIpList(); // get node neighbors list
-
-  MyTag tag;
-  std::vector<ns3::MyTag::NeighInfos> neighInfosVectorTag; 
-  std::vector<ns3::MyTag::NeighborFull> neighListFull;
-
   ns3::MyTag::NeighInfos nodeInfo;
 
-  // Insert malicious node information in a tag
+  // Insert malicious node information in the alerts of its tag value
   nodeInfo.ip = maliciousIP;
   nodeInfo.x = position.x;
   nodeInfo.y = position.y;
   nodeInfo.z = position.z; 
   nodeInfo.hop = 1;
   nodeInfo.state = state;
-  neighInfosVectorTag.push_back(nodeInfo);
-  tag.SetSimpleValue(tagValue);
-  tag.SetNNeighbors(1); 
-  tag.SetPosition(nPosition); // Add nodes position to tag
-  tag.SetNeighInfosVector(neighInfosVectorTag);
+  nodeInfo.infoTime = Simulator::Now().GetSeconds(); // Position just received from it
+  m_pendingAlerts[tagValue].push_back(nodeInfo);
 
-  timeNow = Simulator::Now().GetSeconds();
-  
-  tag.SetMessageTime(timeNow);
+  if (!m_alertEvent.IsRunning()) {
+    m_alertEvent = Simulator::Schedule(m_alertBatchDelay, &FlySafePacketSink::SendAlerts, this);
+  }
+}
+
+/**
+ * @brief Send the queued alerts to neighbor nodes (one hop away and not
+ * among the suspects), one message per tag value
+ * @date Feb 22, 2024
+ * @date Feb 25, 2024 - The sent trace fires once per suspect of a message,
+ * so Statistics keeps counting notifications and not messages
+ */
+void FlySafePacketSink::SendAlerts(){
   
-  neighListFull = GetNeighborIpListFull();
+  double timeNow;
+  string textLog;
+  string message;
 
-  switch ((int)tagValue) {
-  case 4: // Suspicious neighbor notification
-    textLog = "suspicious";
-    message = "Suspicious";
-    break;
-  case 5: // Blocked neighbor notification
-    textLog = "blocked";
-    message = "Blocked";
-    break;
-  case 6: // Suspicious reduction notification
-    textLog = "suspicious reduction on";
-    message = "Suspicious Reduction";
-    break;
-  }
+  Vector nPosition = GetNodeActualPosition();
 
+  int nNeighbors = m_table->GetNNeighbors();
 
+  Ptr<const NeighborSnapshot> neighListFull;
 
-  for (uint8_t i = 0; i < neighborList.size(); i++) { 
+  timeNow = Simulator::Now().GetSeconds();
+  neighListFull = GetNeighborIpListFull();
 
-    // Notify one hop neighbors only and not blocked 
-    if((int)ThisNode->GetNeighborHop(neighborList[i]) == 1 && neighborList[i] != maliciousIP){      
-      cout << m_nodeIP << " : " << timeNow 
-           << " FlySafePacketSink - Sent notification about " << textLog << " node "
-           << maliciousIP << " to "<< neighborList[i] << " - Tag " << (int)tagValue
-           << " - I have " << (int)ThisNode->GetNMaliciousNodes() << " neighbors" << std::endl; 
+  for (auto &pending : m_pendingAlerts) {
+    uint8_t tagValue = pending.first;
+    std::vector<ns3::MyTag::NeighInfos> &alerts = pending.second;
 
-      Address DestinyAddress(InetSocketAddress(neighborList[i], 9));
-      Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+    switch ((int)tagValue) {
+    case 4: // Suspicious neighbor notification
+      textLog = "suspicious";
+      message = "Suspicious";
+      break;
+    case 5: // Blocked neighbor notification
+      textLog = "blocked";
+      message = "Blocked";
+      break;
+    case 6: // Suspicious reduction notification
+      textLog = "suspicious reduction on";
+      message = "Suspicious Reduction";
+      break;
+    }
 
-      if (socket->Bind() == -1) {
-        NS_FATAL_ERROR("Failed to bind socket");
+    // Alerts beyond the capacity of a message go in the next ones
+    for (size_t first = 0; first < alerts.size(); first += MyTag::MAX_ALERT_ENTRIES) {
+      size_t last = std::min(alerts.size(), first + (size_t)MyTag::MAX_ALERT_ENTRIES);
+      std::vector<ns3::MyTag::NeighInfos> neighInfosVectorTag = m_notifyTag.TakeNeighInfosVector();
+      neighInfosVectorTag.assign(alerts.begin() + first, alerts.begin() + last); // Keeps the storage of the previous alerts
+
+      m_notifyTag.SetSimpleValue(tagValue);
+      m_notifyTag.SetNNeighbors(neighInfosVectorTag.size()); 
+      m_notifyTag.SetPosition(nPosition); // Add nodes position to tag
+      m_notifyTag.SetMessageTime(timeNow);
+      m_notifyTag.SetAlertList(true);
+      m_notifyTag.SetNeighInfosVector(std::move(neighInfosVectorTag));
+
+      const std::vector<ns3::MyTag::NeighInfos> &suspects = m_notifyTag.GetNeighInfosVector();
+      Ptr<Packet> notification; // Created on first use, copied to each neighbor
+
+      // Sorted once, so skipping the suspects among the neighbors is a binary search - Feb 25, 24
+      std::vector<Ipv4Address> suspectIps;
+      suspectIps.reserve(suspects.size());
+      for (const auto &n : suspects) {
+        suspectIps.push_back(n.ip);
       }
+      std::sort(suspectIps.begin(), suspectIps.end());
+
+      cout << m_nodeIP << " : " << timeNow 
+           << " FlySafePacketSink - Notification about " << textLog << " node(s) - Tag " 
+           << (int)tagValue << ":" << std::endl; 
+      PrintNeighborList(suspects);
+
+      for (int i = 0; i < nNeighbors; i++) { 
+        FlySafeNeighborTable::Neighbor neighbor = m_table->GetNeighbor(i);
+        bool suspect = std::binary_search(suspectIps.begin(), suspectIps.end(), neighbor.ip);
+
+        // Notify one hop neighbors only and not blocked 
+        if((int)neighbor.hop == 1 && !suspect){      
+          cout << m_nodeIP << " : " << timeNow 
+               << " FlySafePacketSink - Sent notification about " << suspects.size() << " " << textLog << " node(s) to "
+               << neighbor.ip << " - Tag " << (int)tagValue
+               << " - I have " << (int)m_table->GetNMaliciousNodes() << " neighbors" << std::endl; 
 
-      socket->Connect(DestinyAddress);
-      Ptr<Packet> packet;
-      packet = Create<Packet>(reinterpret_cast<const uint8_t *>(message.c_str()), message.size()); // Create a packet to send the message 
-      packet->AddPacketTag(tag); // add the tag to packet
-      socket->Send(packet); // Send packet
-      socket->Close();  // Close socket
-      m_txTrace(timeNow, m_nodeIP,neighborList[i],(int)tagValue,message.c_str(), position, neighListFull); // Callback for id message sent
+          if (!notification) {
+            notification = CreateMessage(m_notifyTag);
+          }
+          SendMessageCopy(neighbor.ip, notification);
+          // One trace per suspect, as when each alert had its own message - Feb 25, 24
+          for (const auto &n : suspects) {
+            Vector position(n.x, n.y, n.z);
+            m_txTrace(timeNow, m_nodeIP,neighbor.ip,(int)tagValue,message.c_str(), position, neighListFull); // Callback for id message sent
+          }
+        }
+      }
     }
+    alerts.clear(); // Keeps the storage for the next round
   } 
-// End NotifyNeighbors
+// End SendAlerts
 }
 
 } // namespace ns3
@@ -11,6 +11,8 @@
 //#include "flysafe-tag.h"
 #include "ns3/utils.h"
 #include "ns3/flysafe-tag.h"
+#include "ns3/flysafe-header.h"
+#include "ns3/flysafe-neighbor-table.h"
 
 using namespace std;
 
@@ -35,19 +37,8 @@ public:
   virtual ~FlySafePacketSink();
   void Setup(Address addressTo, uint32_t protocolId, double maliciousTime);
 
-  /**
-  * @brief Struct to store infos from a neighbor node
-  * @date 25022023
-  */
-  struct NeighInfos {
-        Ipv4Address ip;
-        double x;
-        double y;
-        double z;
-        uint8_t hop;
-        uint8_t state;
-  };   
-
+protected:
+  virtual void DoDispose(void);
 private:
   // inherited from Application base class.
   void StartApplication();
@@ -57,9 +48,45 @@ private:
   void ManipulatePeerClose(Ptr<Socket> socket);
   void ManipulatePeerError(Ptr<Socket> socket);
   void ManipulateAccept(Ptr<Socket> s, const Address &from);
-  void SendMessage(Address addressTo, string message, uint8_t tagy, 
-                   u_int32_t nNeigbors, Vector nodePosition,
-                   std::vector<ns3::MyTag::NeighInfos> nodeInfos);
+  void SendMessage(Address addressTo, uint8_t tagy, 
+                   u_int32_t nNeigbors, Vector nodePosition);
+
+  /**
+   * @brief Load node NL into a tag, reusing the tag NL storage
+   * @date Feb 22, 2024
+   * 
+   * @param tag Tag to receive the NL
+   */
+  void LoadNeighInfos(MyTag &tag);
+
+  /**
+   * @brief Create a message with a fixed size payload and a FlySafe tag
+   * @date Feb 22, 2024
+   * 
+   * @param tag Tag with the message data
+   * @return Ptr<Packet> Message to send, or to copy for each destination
+   */
+  Ptr<Packet> CreateMessage(MyTag &tag);
+
+  /**
+   * @brief Send a copy of a message to a neighbor node
+   * @date Feb 22, 2024
+   * @date Feb 24, 2024 - UDP messages share one socket
+   * 
+   * @param addressTo Neighbor node IPv4 address
+   * @param message Message created by CreateMessage
+   */
+  void SendMessageCopy(Ipv4Address addressTo, Ptr<const Packet> message);
+
+  /**
+   * @brief Add a FlySafe tag to a packet, with the configured position encoding
+   * @date Feb 19, 2024
+   * @date Feb 23, 2024 - As a FlySafeHeader with the header transport
+   * 
+   * @param packet Packet to send
+   * @param tag Tag with the message data
+   */
+  void AddMessageTag(Ptr<Packet> packet, MyTag &tag);
   
   /**
    * \brief Get node nodes actual position
@@ -91,7 +118,7 @@ private:
    * 
    * @param neighInfos Vector of structs with neighbor nodes information
    */
-  void UpdateMyNeighborList(std::vector<ns3::MyTag::NeighInfos> neighInfos); 
+  void UpdateMyNeighborList(const std::vector<ns3::MyTag::NeighInfos> &neighInfos); 
 
 
   /**
@@ -105,13 +132,6 @@ private:
   uint8_t CheckNeighAttitude(double newDistance, double oldDistance);
 
 
-  /**
-   * @brief Create a vector from node neighbor list
-   * 
-   */
-  std::vector<NeighInfos> GetNeighborListVector();
-
-
   /**
    * @brief Puts neighbors information in a string
    * @date Mar 28, 2023
@@ -124,9 +144,9 @@ private:
    * @brief Get the Neighbor Ip List Full object
    * @date Apr 7, 2023
    * 
-   * @return vector<ns3::MyTag::NeighborFull> 
+   * @return Ptr<const NeighborSnapshot> - Shared, immutable copy of the NL
    */
-  vector<ns3::MyTag::NeighborFull> GetNeighborIpListFull();
+  Ptr<const NeighborSnapshot> GetNeighborIpListFull();
 
   /**
    * @brief Get malicious neighbor list from the node
@@ -145,6 +165,12 @@ private:
    */
   void NotifyNeighbors(Ipv4Address maliciousIP, Vector position, uint8_t state, uint8_t tagValue);
 
+  /**
+   * @brief Send the queued alerts to neighbor nodes, one message per tag value
+   * @date Feb 22, 2024
+   */
+  void SendAlerts();
+
 //}
 
   // inherited from Application base class.
@@ -152,6 +178,7 @@ private:
   uint64_t m_totalRx;             //!< Total bytes received
   TypeId m_tid;                   //!< Protocol TypeId
   Ptr<Socket> m_socket;           //!< Listening socket
+  Ptr<Socket> m_unicastSocket;    //!< Bound socket sending the UDP unicasts
   list<Ptr<Socket>> m_socketList; //!< the accepted sockets
   EventId m_sendEvent;            //!< Event id of pending "send packet" event
 
@@ -159,20 +186,31 @@ private:
   string m_myId;                  //!< store competence + interests
   Address m_node;                 //!< Application node address
   Ipv4Address m_nodeIP;           //!< Node's IPv4 Address
+  Ptr<FlySafeNeighborTable> m_table; //!< FlySafe state aggregated to the node
   double m_maliciousTime;         //!< Store the time a node becomes malicious (default: 9999.99)
+  MyTag::PositionEncoding m_positionEncoding; //!< How positions are written in the tags
+  uint32_t m_payloadSize;         //!< Payload size of the FlySafe messages
+  FlySafeHeader::Transport m_transport; //!< How the messages are carried (tag or header)
+  MyTag m_txTag;                  //!< Tag reused by the identifications, keeps the NL storage
+  MyTag m_notifyTag;              //!< Tag reused by the neighbor notifications
+  Time m_alertBatchDelay;         //!< Time the alerts are held to be sent together
+  EventId m_alertEvent;           //!< Event id of the pending alerts sending
+  std::map<uint8_t, std::vector<ns3::MyTag::NeighInfos>> m_pendingAlerts; //!< Alerts to send, by tag value
 
   TracedCallback<Ptr<const Packet>, const Address &>
       m_rxTrace;              //!< Traced Callback: received packets, source address.
   TracedCallback<Ptr<const Packet>, const Address &, const Address &>
       m_rxTraceWithAddresses; //!< Traced Callback: received packets, source and
                               //!< destination address.
-  TracedCallback<double, Vector, Ipv4Address, Ipv4Address, int, string, std::vector<ns3::MyTag::NeighborFull>, 
+  TracedCallback<double, Vector, Ipv4Address, Ipv4Address, int, string, Ptr<const NeighborSnapshot>, 
       double> m_sinkTrace;   //!< Traced Callback: received messages 
       //double, std::vector<ns3::MyTag::MaliciousNode>> m_sinkTrace;   //!< Traced Callback: received messages 
-  TracedCallback <double, Ipv4Address, Ipv4Address, int, string, Vector,std::vector<ns3::MyTag::NeighborFull>> 
+  TracedCallback <double, Ipv4Address, Ipv4Address, int, string, Vector,Ptr<const NeighborSnapshot>> 
       m_txTrace;              //!< Traced value to sent messages
   TracedCallback<double, Ipv4Address, std::vector<ns3::MyTag::MaliciousNode>> 
       m_sinkMaliciousTrace;   //!< Traced Callback: received messages 
+  TracedCallback<double, Ipv4Address, double>
+      m_quantizationTrace;    //!< Traced Callback: position error of the sent tags
   bool m_maliciousRegister;                         //!< Register wether a node becomes malicious
 };
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "flysafe-statistics.h"
 
 namespace ns3 {
@@ -10,7 +12,8 @@ namespace ns3 {
  *
  * Output: NIL
  */
-Statistics::Statistics(string timeLog, string folderTraces) {
+Statistics::Statistics(string timeLog, string folderTraces)
+  : m_positionsGrid(86.0) {
   m_trapMsgSent = 0;
   m_trapMsgReceived = 0;
   m_broadcastSent = 0;
@@ -27,7 +30,12 @@ Statistics::Statistics(string timeLog, string folderTraces) {
   m_blockedNeighborReceived = 0;
   m_suspiciousReductionReceived = 0;
   m_totalMsgReceived = 0;
+  m_quantizedTags = 0;
+  m_quantizedOverTarget = 0;
+  m_quantizationErrorSum = 0.0;
+  m_quantizationErrorMax = 0.0;
   m_nodesPositions = "";
+  m_positionsTime = -1.0;
   m_timeLogFile = timeLog;
   m_folderToTraces = folderTraces;
   m_startTime = 0.0;
@@ -110,7 +118,7 @@ Statistics::AppendLineToFile(ofstream &stream, string file, string msg) {
 void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
                                   Ipv4Address recvAdd, Ipv4Address fromAdd, 
                                   int msgTag, string message,
-                                  vector<ns3::MyTag::NeighborFull> neighList,
+                                  Ptr<const NeighborSnapshot> neighList,
                                   double messageTime) //,
                                   //vector<ns3::MyTag::MaliciousNode> maliciousList)
 {
@@ -204,7 +212,7 @@ void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
   // Append evolution data to file
   textLine.str("");
   textLine << timeNow << "\t" << position.x << "," << position.y 
-           << "," << position.z << "\t" << NeighListToString(neighList);
+           << "," << position.z << "\t" << NeighListToString(neighList->GetNeighbors());
   AppendLineToFile(m_neighFile, fileName.str(), textLine.str());
 
   /*
@@ -222,7 +230,7 @@ void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
   // Append evolution data to file
   textLine.str("");
   textLine << timeNow << "\t" << position.x << "," << position.y 
-           << "," << position.z << "\t" << NeighListToString(neighList);
+           << "," << position.z << "\t" << NeighListToString(neighList->GetNeighbors());
            //NeighMaliciousListToString();
   AppendLineToFile(m_maliciousFile, fileName.str(), textLine.str());
   */
@@ -325,7 +333,7 @@ void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
 
   string neighAnalysis;
 
-  possibleNeighbors = IdentifyPossibleNeighbors(position, nodesPositions);
+  possibleNeighbors = IdentifyPossibleNeighbors(position);
   
   // if ((int)neighList.size() == 0 &&  (int)possibleNeighbors.size() == 0){
   //   cout << recvAdd << " : " << timeNow << " Statistics - Neighbor list is empty!" << endl;
@@ -337,7 +345,7 @@ void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
   // [2] String with spatial awareness analysis
   // [3] String with neighbors distances analysis to gnuplot log file
 
-  evalString = EvaluateNeighborhood(recvAdd, neighList, possibleNeighbors, timeNow);
+  evalString = EvaluateNeighborhood(recvAdd, neighList->GetNeighbors(), possibleNeighbors, timeNow);
   
   
   // *** Saving neighborhood analysis from a node to a file ***
@@ -434,7 +442,7 @@ void Statistics::ReceiverCallback(string path, double timeNow, Vector position,
  */
 void Statistics::SenderCallback(string path, double timeNow, Ipv4Address senderIP,
                                 Ipv4Address targetIP, int msgTag, string message,
-                                Vector position, vector<ns3::MyTag::NeighborFull> neighList) 
+                                Vector position, Ptr<const NeighborSnapshot> neighList) 
 {
   ostringstream fileName;
   ostringstream headerLine;
@@ -529,7 +537,7 @@ void Statistics::SenderCallback(string path, double timeNow, Ipv4Address senderI
   textLine.str("");
   textLine << timeNow << "\t"
            << position.x << "," << position.y << "," << position.z 
-           << "\t" << NeighListToString(neighList);
+           << "\t" << NeighListToString(neighList->GetNeighbors());
   AppendLineToFile(m_neighFile, fileName.str(), textLine.str());
 
 
@@ -585,7 +593,7 @@ void Statistics::SenderCallback(string path, double timeNow, Ipv4Address senderI
 
   // *** Evaluating neighborhood nodes evolution ***
 
-  possibleNeighbors = IdentifyPossibleNeighbors(position, nodesPositions);
+  possibleNeighbors = IdentifyPossibleNeighbors(position);
 
   string neighAnalysis;
   
@@ -595,7 +603,7 @@ void Statistics::SenderCallback(string path, double timeNow, Ipv4Address senderI
   // [2] String with spatial awareness analysis
   // [3] String with neighbors distances analysis to gnuplot log file
   
-  evalString = EvaluateNeighborhood(senderIP, neighList, possibleNeighbors, timeNow);
+  evalString = EvaluateNeighborhood(senderIP, neighList->GetNeighbors(), possibleNeighbors, timeNow);
 
   // *** Saving neighborhood nodes evolution to a file ***
 
@@ -646,7 +654,7 @@ void Statistics::SenderCallback(string path, double timeNow, Ipv4Address senderI
  */
 void Statistics::EmptyNLCallback(string path, double timeNow, Vector position,
                                   Ipv4Address nodeAdd,
-                                  vector<ns3::MyTag::NeighborFull> neighList)
+                                  Ptr<const NeighborSnapshot> neighList)
 {
   ostringstream filename;
   std::vector<NeighInfos> nodesPositions;
@@ -669,7 +677,7 @@ void Statistics::EmptyNLCallback(string path, double timeNow, Vector position,
   // Append neighborhood evolution line to a node file
   textLine << timeNow << "\t"
            << position.x << "," << position.y << "," << position.z 
-           << "\t" << NeighListToString(neighList);
+           << "\t" << NeighListToString(neighList->GetNeighbors());
   AppendLineToFile(m_neighFile, fileName.str(), textLine.str());
 
 
@@ -723,7 +731,7 @@ void Statistics::EmptyNLCallback(string path, double timeNow, Vector position,
 
   // ***Evaluating neighborhood nodes evolution ***
 
-  possibleNeighbors = IdentifyPossibleNeighbors(position, nodesPositions);
+  possibleNeighbors = IdentifyPossibleNeighbors(position);
 
   string neighAnalysis;
   
@@ -735,7 +743,7 @@ void Statistics::EmptyNLCallback(string path, double timeNow, Vector position,
   // [2] String with spatial awareness analysis
   // [3] String with neighbors distances analysis to gnuplot log file
 
-  evalString = EvaluateNeighborhood(nodeAdd, neighList, possibleNeighbors, timeNow);
+  evalString = EvaluateNeighborhood(nodeAdd, neighList->GetNeighbors(), possibleNeighbors, timeNow);
   
   fileName.str("");
   fileName << m_folderToTraces.c_str() << "neighborhood_rx_analysis_" << nodeAdd
@@ -806,7 +814,7 @@ std::vector<ns3::Statistics::NeighInfos> Statistics::IdentifyPossibleNeighbors(V
   Vector neighPosition;
 
   // Calculate the distance between this node to all nodes in simulation 
-  for (uint8_t i = 0; i < allNodesPositions.size(); i++) {
+  for (uint32_t i = 0; i < allNodesPositions.size(); i++) {
     neighPosition.x = allNodesPositions[i].x;
     neighPosition.y = allNodesPositions[i].y;
     neighPosition.z = allNodesPositions[i].z;
@@ -828,15 +836,51 @@ std::vector<ns3::Statistics::NeighInfos> Statistics::IdentifyPossibleNeighbors(V
   return possibleNeighs;
 }
 
+/**
+ * @brief Identify possible neighbors (1 hop only) among all nodes in simulation
+ * @date Feb 7, 2024
+ * 
+ * @param nodePosition Position of the node
+ * @return std::vector<ns3::Statistics::NeighInfos> possible neighbors, in nodes order
+ */
+std::vector<ns3::Statistics::NeighInfos> Statistics::IdentifyPossibleNeighbors(Vector nodePosition){
+  vector<NeighInfos> possibleNeighs;
+  vector<uint32_t> candidates;
+  double distance, value;
+
+  getAllNodesPositions(); // Refresh the grid if the nodes moved
+  m_positionsGrid.GetWithin(nodePosition, 86.0, candidates);
+  std::sort(candidates.begin(), candidates.end()); // Keep the nodes order
+
+  for (auto i : candidates) {
+    NeighInfos neigh = m_positionsCache[i];
+    value = CalculateDistance(nodePosition, Vector(neigh.x, neigh.y, neigh.z));
+    distance = std::ceil(value * 100.0) / 100.0; // 2 decimal cases
+    neigh.distance = distance;
+    if (distance > 0.0 && distance < 86.0){
+      possibleNeighs.push_back(neigh);
+    }
+  }
+  return possibleNeighs;
+}
+
 /**
  * @brief Get all nodes positions 
  * 
+ * Positions are read once per simulation time and kept, with their grid,
+ * until the time changes.
+ * 
  * @return std::vector<ns3::Statistics::NeighInfos> vector with nodes positions
  */
 std::vector<ns3::Statistics::NeighInfos> Statistics::getAllNodesPositions(){
+  NodeContainer c =  NodeContainer::GetGlobal ();
+  double timeNow = Simulator::Now().GetSeconds();
+  if (timeNow == m_positionsTime && m_positionsCache.size() == c.GetN()) {
+    return m_positionsCache;
+  }
+
   std::vector<NeighInfos> nodesPositions;
   NeighInfos nodePosition;
-  NodeContainer c =  NodeContainer::GetGlobal ();
   ostringstream positionInfos;
 
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
@@ -856,6 +900,14 @@ std::vector<ns3::Statistics::NeighInfos> Statistics::getAllNodesPositions(){
       nodePosition.ip = iaddr.GetLocal();
       nodesPositions.push_back(nodePosition);
     }
+
+  m_positionsTime = timeNow;
+  m_positionsCache = nodesPositions;
+  m_positionsGrid.Clear();
+  for (uint32_t i = 0; i < m_positionsCache.size(); i++) {
+    m_nodeIds.Intern(m_positionsCache[i].ip); // First call: id is the node index
+    m_positionsGrid.Insert(i, Vector(m_positionsCache[i].x, m_positionsCache[i].y, m_positionsCache[i].z));
+  }
   return nodesPositions;
 
 }
@@ -902,7 +954,7 @@ string Statistics::getNodesDistances(Ipv4Address nodeIP, std::vector<ns3::Statis
  * @param neighList neighbor list vector
  * @return string neighbor list on string
  */
-string Statistics::NeighListToString(vector<ns3::MyTag::NeighborFull> neighList){
+string Statistics::NeighListToString(const vector<ns3::MyTag::NeighborFull> &neighList){
 ostringstream neighString;
 
   for(auto n : neighList){
@@ -955,7 +1007,7 @@ string Statistics::NeighMaliciousListToString(vector<ns3::MyTag::MaliciousNode>
 //std::string 
 // void
 std::vector<std::string>
-Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::NeighborFull> neighList, 
+Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, const vector<ns3::MyTag::NeighborFull> &neighList, 
                                  std::vector<ns3::Statistics::NeighInfos> possibleNeighs,
                                  double timeNow){
   vector<string> results;
@@ -966,17 +1018,27 @@ Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::Neighbor
   vector <int> PNCtrl((int)possibleNeighs.size(),0); // Store neighbors not identified
   vector <double> distanceError;
 
+  // Join both lists on dense node ids: one bitset per list
+  m_neighborIds.Clear();
+  m_possibleIds.Clear();
+  for (z = 0; z < (int)possibleNeighs.size(); z++){
+    uint32_t id = m_nodeIds.Intern(possibleNeighs[z].ip);
+    m_possibleIds.Insert(id);
+    if (id >= m_possiblePosition.size()){
+      m_possiblePosition.resize(m_nodeIds.GetN());
+    }
+    m_possiblePosition[id] = z; // Only read for ids in m_possibleIds
+  }
   for (i = 0; i < (int)neighList.size(); i++){
-    for (z = 0; z < (int)possibleNeighs.size(); z++){
-      if (neighList[i].ip == nodeIP){ // Discard the node itself
-        break;
-      }
-      if (neighList[i].ip == possibleNeighs[z].ip){
-        NLCtrl[i] = 1;
-        PNCtrl[z] = 1;
-        break;
-      }
+    if (neighList[i].ip == nodeIP || possibleNeighs.empty()){ // Discard the node itself
+      continue;
     }
+    uint32_t id = m_nodeIds.Intern(neighList[i].ip);
+    m_neighborIds.Insert(id);
+    NLCtrl[i] = m_possibleIds.Contains(id);
+  }
+  for (z = 0; z < (int)possibleNeighs.size(); z++){
+    PNCtrl[z] = m_neighborIds.Contains(m_nodeIds.Find(possibleNeighs[z].ip));
   }
 
   //cout << "Neighbors correctly identified: " << endl;
@@ -1015,7 +1077,7 @@ Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::Neighbor
     strFinal << "\t" << (int)possibleNeighs.size() << "," << pNeighs.str().substr(0,pNeighs.str().size()-1);
   }
 
-  yes = accumulate(NLCtrl.begin(), NLCtrl.end(),0); // Sum vector values
+  yes = m_neighborIds.CountCommon(m_possibleIds); // Both lists hold distinct nodes
   if (yes == 0){ // Neighbors are not plausible neighbors
     strFinal << "\t" << 0; 
   }
@@ -1023,7 +1085,7 @@ Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::Neighbor
     strFinal << "\t" << yes << "," << strFound.str().substr(0,strFound.str().size()-1); 
   }
 
-  no = (int)PNCtrl.size() - accumulate(PNCtrl.begin(), PNCtrl.end(),0); // Plausible neighbors not identified  
+  no = (int)PNCtrl.size() - yes; // Plausible neighbors not identified  
   if(no == 0){
     strFinal << "\t"; 
   }
@@ -1115,17 +1177,14 @@ Statistics::EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::Neighbor
     for (i = 0; i < (int)NLCtrl.size(); i++){
       //cout << "Localization evaluation: ";
       if (NLCtrl[i] == 1){
-        for(auto n : possibleNeighs){
-          if(neighList[i].ip == n.ip){
-            //cout << "IP " << n.ip << " Distance in NL: " << neighList[i].distance << " Real distance: " << n.distance;
-            dist = neighList[i].distance - n.distance;
-            if (dist < 0){
-              dist = dist * (-1);
-            }
-            //cout << " Error: " << dist;
-            distanceError.push_back(dist);
-          }
+        const NeighInfos &n = possibleNeighs[m_possiblePosition[m_nodeIds.Find(neighList[i].ip)]];
+        //cout << "IP " << n.ip << " Distance in NL: " << neighList[i].distance << " Real distance: " << n.distance;
+        dist = neighList[i].distance - n.distance;
+        if (dist < 0){
+          dist = dist * (-1);
         }
+        //cout << " Error: " << dist;
+        distanceError.push_back(dist);
       }
       //cout << endl;
     }
@@ -1267,6 +1326,7 @@ void Statistics::UpdateMaliciousStateControl(double timeNow, Ipv4Address nodeIP,
         tempMalicious.tBlocked = timeNow;
       }
       tempMalicious.avgTime = 0.0;
+      m_maliciousControlIndex[GetControlKey(nodeIP, n.ip)] = m_maliciousControlState.size();
       m_maliciousControlState.push_back(tempMalicious);
     }
   }
@@ -1284,15 +1344,7 @@ void Statistics::UpdateMaliciousStateControl(double timeNow, Ipv4Address nodeIP,
  * @return false - Node not under control
  */
 bool Statistics::IsInControlStateList(Ipv4Address nodeIP, Ipv4Address maliciousIP){
-  bool inList = false;
-
-  for (auto n : m_maliciousControlState){
-    if (n.nodeIP == nodeIP && n.maliciousIP == maliciousIP){
-      inList = true;
-      break;
-    }
-  }
-  return inList;
+  return LookupControlState(nodeIP, maliciousIP) != 0;
 }
 
 /**
@@ -1306,15 +1358,8 @@ bool Statistics::IsInControlStateList(Ipv4Address nodeIP, Ipv4Address maliciousI
  * @return uint8_t malicious node state (0 suspect, 1 blocked)
  */
 uint8_t Statistics::GetMaliciousControleState(Ipv4Address nodeIP, Ipv4Address maliciousIP){
-  uint8_t mState = 0;
-
-  for (auto n :m_maliciousControlState){
-    if (n.nodeIP == nodeIP && n.maliciousIP == maliciousIP) {
-      mState = n.maliciousState;
-      break;
-    }
-  }
-  return mState;
+  MaliciousControl *control = LookupControlState(nodeIP, maliciousIP);
+  return control ? control->maliciousState : 0;
 }
 
 
@@ -1329,18 +1374,48 @@ uint8_t Statistics::GetMaliciousControleState(Ipv4Address nodeIP, Ipv4Address ma
  * @param tBlocked blocked time
  */
 void Statistics::SetMaliciousBlockedTime(Ipv4Address nodeIP, Ipv4Address maliciousIP, double tBlocked){
+  MaliciousControl *control = LookupControlState(nodeIP, maliciousIP);
+  if (control){
+    cout << nodeIP << " : " << tBlocked << " Statistics - Set Malicious Blocked Time for node " << maliciousIP << endl;
+    control->maliciousState = 1;
+    control->tBlocked = tBlocked;
+    control->avgTime = control->tBlocked - control->tSuspicious;
+  }
+}
 
-  for (MaliciousHandlerList::iterator i = m_maliciousControlState.begin (); i != m_maliciousControlState.end (); i++){
-    if (i->nodeIP == nodeIP && i->maliciousIP == maliciousIP) {
-      cout << nodeIP << " : " << tBlocked << " Statistics - Set Malicious Blocked Time for node " << maliciousIP << endl;
-      i->maliciousState = 1;
-      i->tBlocked = tBlocked;
-      i->avgTime = i->tBlocked - i->tSuspicious;
-      break;
-    }
+/**
+ * @brief Key of a pair of nodes in the malicious control index
+ * 
+ * @date Feb 9, 2024
+ * 
+ * @param nodeIP node IP controlling malicious neighbors
+ * @param maliciousIP malicious node IP
+ * @return uint64_t node id in the high half, malicious node id in the low half
+ */
+uint64_t Statistics::GetControlKey(Ipv4Address nodeIP, Ipv4Address maliciousIP){
+  return ((uint64_t)m_nodeIds.Intern(nodeIP) << 32) | m_nodeIds.Intern(maliciousIP);
+}
+
+/**
+ * @brief Find the control data of a malicious node seen by a node
+ * 
+ * @date Feb 9, 2024
+ * 
+ * @param nodeIP node IP controlling malicious neighbors
+ * @param maliciousIP malicious node IP
+ * @return MaliciousControl* control data or 0 if not under control
+ */
+Statistics::MaliciousControl *Statistics::LookupControlState(Ipv4Address nodeIP, Ipv4Address maliciousIP){
+  std::unordered_map<uint64_t, uint32_t>::const_iterator i =
+    m_maliciousControlIndex.find(GetControlKey(nodeIP, maliciousIP));
+  if (i == m_maliciousControlIndex.end()){
+    return 0;
   }
+  return &m_maliciousControlState[i->second];
 }
 
+
+
 void Statistics::PrintMaliciousControlStateList(){
 
     if((int)m_maliciousControlState.size() == 0){
@@ -1458,6 +1533,50 @@ void Statistics::MaliciousControlResumeLogFile(string simDate){
 }
 
 
+/**
+ * @brief Statistics of the FlySafe applications - Position error of the sent tags
+ * @date Feb 19, 2024
+ * 
+ * @param path
+ * @param timeNow Simulation time 
+ * @param nodeAdd Sender node IPv4 address
+ * @param error Largest position error in the tag, in meters
+ */
+void Statistics::QuantizationErrorCallback(string path, double timeNow, Ipv4Address nodeAdd,
+                                           double error)
+{
+  m_quantizedTags++;
+  m_quantizationErrorSum += error;
+  m_quantizationErrorMax = std::max(m_quantizationErrorMax, error);
+  if (error > 2.0) { // GNSS class positioning target of the UAV
+    m_quantizedOverTarget++;
+  }
+}
+
+
+/**
+ * @brief Save the position error of the quantized tags to a log file
+ * @date Feb 19, 2024
+ */
+void Statistics::QuantizationResumeLogFile(string simDate){
+  ostringstream textLine;
+  ostringstream fileName; 
+
+  if (m_quantizedTags == 0){ // Positions sent as doubles, nothing to report
+    return;
+  }
+
+  fileName << m_folderToTraces.c_str() << "quantization_error_"
+          << simDate.substr(0, simDate.size() - 2).c_str() << ".txt";
+
+  textLine << "tags" << "\t" << "avgError" << "\t" << "maxError" << "\t" << "overTarget" << endl;
+  textLine << m_quantizedTags << "\t" << m_quantizationErrorSum / m_quantizedTags << "\t" 
+           << m_quantizationErrorMax << "\t" << m_quantizedOverTarget << endl;
+
+  AppendHeaderToFile(m_maliciousFile, fileName.str(), textLine.str());
+}
+
+
 } // namespace ns3
 
 /* ------------------------------------------------------------------------
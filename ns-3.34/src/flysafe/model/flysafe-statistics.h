@@ -1,4 +1,5 @@
 #include <fstream>
+#include <unordered_map>
 
 #include "ns3/address-utils.h"
 #include "ns3/address.h"
@@ -9,6 +10,9 @@
 #include "ns3/vector.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/position-grid.h"
+#include "ns3/ipv4-address-interner.h"
+#include "ns3/node-id-set.h"
 #include "ns3/utils.h"
 
 using namespace std;
@@ -31,7 +35,7 @@ public:
   void ReceiverCallback(string path, double timeNow, Vector position, 
                         Ipv4Address recvAdd, Ipv4Address fromAdd,
                         int msgTag, string message, 
-                        vector<ns3::MyTag::NeighborFull> neighList,
+                        Ptr<const NeighborSnapshot> neighList,
                         double messageTime);//,
                         //vector<ns3::MyTag::MaliciousNode> maliciousList);
 
@@ -43,7 +47,7 @@ public:
 
   void SenderCallback(string path, double timeNow, Ipv4Address senderAdd, 
                       Ipv4Address targetAdd, int msgTag, string message,
-                      Vector position, vector<ns3::MyTag::NeighborFull> neighList);
+                      Vector position, Ptr<const NeighborSnapshot> neighList);
 
   /**
   * @brief Statistics of FlySafePacketSink Application - Monitors nodes with empty NL 
@@ -57,7 +61,19 @@ public:
   */
   void EmptyNLCallback(string path, double timeNow, Vector position,
                        Ipv4Address nodeAdd,
-                       vector<ns3::MyTag::NeighborFull> neighList);
+                       Ptr<const NeighborSnapshot> neighList);
+
+  /**
+  * @brief Statistics of the FlySafe applications - Position error of the sent tags
+  * @date Feb 19, 2024
+  * 
+  * @param path
+  * @param timeNow Simulation time 
+  * @param nodeAdd Sender node IPv4 address
+  * @param error Largest position error in the tag, in meters
+  */
+  void QuantizationErrorCallback(string path, double timeNow, Ipv4Address nodeAdd,
+                                 double error);
 
   /**
    * @brief Update state of malicious nodes
@@ -143,6 +159,17 @@ public:
   std::vector<ns3::Statistics::NeighInfos>
   IdentifyPossibleNeighbors(Vector nodePosition, std::vector<ns3::Statistics::NeighInfos> neighPositions);
 
+  /**
+   * @brief Identify possible neighbors (1 hop only) among all nodes in simulation
+   * @date Feb 7, 2024
+   * 
+   * Uses the grid of the current nodes positions, so the cost depends on
+   * the number of nodes around nodePosition only.
+   * 
+   * @param nodePosition Position of the node
+   */
+  std::vector<ns3::Statistics::NeighInfos> IdentifyPossibleNeighbors(Vector nodePosition);
+
   /**
    * @brief Converts neighbor list vector to string
    * @date Apr 7, 2023
@@ -150,7 +177,7 @@ public:
    * @param neighList neighbor list vector
    * @return string neighbor list on string
    */
-  string NeighListToString(vector<ns3::MyTag::NeighborFull> neighList);
+  string NeighListToString(const vector<ns3::MyTag::NeighborFull> &neighList);
 
   /**
    * @brief Converts malicious neighbor list vector to string
@@ -186,7 +213,7 @@ public:
    * @param possibleNeighs Possible neighbors from all nodes available in the simulation
    */
   std::vector<std::string>
-  EvaluateNeighborhood(Ipv4Address nodeIP, vector<ns3::MyTag::NeighborFull> neighList, 
+  EvaluateNeighborhood(Ipv4Address nodeIP, const vector<ns3::MyTag::NeighborFull> &neighList, 
                                    std::vector<ns3::Statistics::NeighInfos> possibleNeighs,
                                    double timeNow);
 
@@ -206,6 +233,14 @@ public:
    */
   void MaliciousControlResumeLogFile(string simDate);
 
+  /**
+   * @brief Save the position error of the quantized tags to a log file
+   * @date Feb 19, 2024
+   * 
+   * @param simDate Simulation date and time string
+   */
+  void QuantizationResumeLogFile(string simDate);
+
 
   /**
    * @brief Verify wether a malicious node is already under control by another node
@@ -237,6 +272,13 @@ public:
   uint32_t m_suspiciousReductionReceived;   //!< Store number of messages reduction received
   uint32_t m_totalMsgReceived;              //!< Store the total number of messages received
   string m_nodesPositions;          //!< Store nodes positions in a time instant
+  double m_positionsTime;           //!< Time of the cached nodes positions
+  std::vector<NeighInfos> m_positionsCache; //!< All nodes positions at m_positionsTime
+  PositionGrid m_positionsGrid;     //!< m_positionsCache indexes by position
+  Ipv4AddressInterner m_nodeIds;    //!< Dense ids of nodes IPs, node index for simulation nodes
+  NodeIdSet m_neighborIds;          //!< Scratch set of NL ids for EvaluateNeighborhood
+  NodeIdSet m_possibleIds;          //!< Scratch set of possible neighbors ids for EvaluateNeighborhood
+  std::vector<uint32_t> m_possiblePosition; //!< Scratch position in possibleNeighs by id for EvaluateNeighborhood
 
   // Global variables for sent messages
   uint32_t m_broadcastSent;         //!< Store number of broadcast messages sent
@@ -248,6 +290,12 @@ public:
   uint32_t m_suspiciousReductionSent;   //!< Store number of messages reduction sent
   uint32_t m_totalMsgSent;              //!< Store the total number of messages sent
 
+  // Global variables for position quantization
+  uint32_t m_quantizedTags;         //!< Store number of tags sent with quantized positions
+  uint32_t m_quantizedOverTarget;   //!< Store number of tags whose error exceeds the positioning target
+  double m_quantizationErrorSum;    //!< Store the sum of the tags position errors
+  double m_quantizationErrorMax;    //!< Store the largest tag position error
+
 
   string m_timeLogFile;             //!< Store the simulation start moment to append in logs file names
   string m_recvTracesFile;          //!< Store received msg traces file name
@@ -266,6 +314,23 @@ public:
 
   typedef std::vector<struct MaliciousControl> MaliciousHandlerList;
   MaliciousHandlerList m_maliciousControlState;
+  std::unordered_map<uint64_t, uint32_t> m_maliciousControlIndex; //!< (node id, malicious id) to m_maliciousControlState position
+
+  /**
+   * @brief Find the control data of a malicious node seen by a node
+   * @date Feb 9, 2024
+   * 
+   * @param nodeIP node IP controlling malicious neighbors
+   * @param maliciousIP malicious node IP
+   * @return MaliciousControl* control data or 0 if not under control
+   */
+  MaliciousControl *LookupControlState(Ipv4Address nodeIP, Ipv4Address maliciousIP);
+
+  /**
+   * @brief Key of a pair of nodes in m_maliciousControlIndex
+   * @date Feb 9, 2024
+   */
+  uint64_t GetControlKey(Ipv4Address nodeIP, Ipv4Address maliciousIP);
   // std::vector<struct MaliciousControl> m_maliciousControlState; //!< Store malicious control data
 };
 } // namespace ns3
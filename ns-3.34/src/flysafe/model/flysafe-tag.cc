@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "flysafe-tag.h"
 #include "ns3/vector.h"
 
@@ -30,15 +34,183 @@ TypeId MyTag::GetTypeId(void) {
 
 TypeId MyTag::GetInstanceTypeId(void) const { return GetTypeId(); }
 
+MyTag::MyTag()
+  : m_simpleValue(0),
+    m_nNeighborsValue(0),
+    m_messageTime(0),
+    m_positionEncoding(POSITION_DOUBLE),
+    m_deltaList(false),
+    m_alertList(false) {
+}
+
+/// Bytes of one NeighInfos on the wire besides its position: ip, hop, state and age
+static const uint32_t NEIGH_INFOS_WIRE_SIZE = 4 + 1 + 1 + 2;
+
+/// Oldest information age on the wire, in centiseconds (655.35 s)
+static const double MAX_INFO_AGE = std::numeric_limits<uint16_t>::max();
+
+/**
+ * @brief Age of an entry at the message time, in centiseconds, saturating
+ * @date Feb 21, 2024
+ */
+static uint16_t EncodeInfoAge(double messageTime, double infoTime) {
+	double age = std::floor((messageTime - infoTime) * 100.0 + 0.5);
+	return (uint16_t)std::min(std::max(age, 0.0), MAX_INFO_AGE);
+}
+
+/// Bit of the encoding byte set when the NL carries only changed entries
+static const uint8_t DELTA_LIST_FLAG = 0x80;
+
+/// Bit of the encoding byte set when the NL is sent as a compact alert
+static const uint8_t ALERT_LIST_FLAG = 0x40;
+
+/// Bit of the encoding byte set when the message is for some NL entries only
+static const uint8_t TRAP_TARGETS_FLAG = 0x20;
+
+/// Bit of an entry state set when the message is for that node
+static const uint8_t TRAP_TARGET_STATE = 0x80;
+
+/// Bytes of one alert entry on the wire besides its position: ip and state
+static const uint32_t ALERT_WIRE_SIZE = 4 + 1;
+
+/**
+ * @brief Position encoding really written. Alerts always send quantized
+ * positions, relative to the notifier position.
+ * @date Feb 22, 2024
+ */
+static MyTag::PositionEncoding GetWireEncoding(MyTag::PositionEncoding encoding, bool alert) {
+	return alert ? MyTag::POSITION_RELATIVE : encoding;
+}
+
+const uint32_t MyTag::MAX_ALERT_ENTRIES;
+
+/**
+ * @brief Number of entries an alert carries
+ * @date Feb 22, 2024
+ */
+static uint32_t GetAlertEntries(size_t entries) {
+	return (uint32_t)std::min(entries, (size_t)MyTag::MAX_ALERT_ENTRIES);
+}
+
+/**
+ * @brief Bytes of one position on the wire
+ * @date Feb 19, 2024
+ *
+ * @param encoding Position encoding
+ * @param entry True for a NL entry, false for the sender position
+ */
+static uint32_t GetPositionWireSize(MyTag::PositionEncoding encoding, bool entry) {
+	switch (encoding) {
+	case MyTag::POSITION_CENTIMETERS:
+		return 3 * 4;
+	case MyTag::POSITION_RELATIVE:
+		return entry ? 3 * 2 : 3 * 4;
+	default:
+		return 3 * 8;
+	}
+}
+
+/**
+ * @brief Round a coordinate to centimeters, saturating at the int32 range
+ * @date Feb 19, 2024
+ */
+static int32_t EncodeCentimeters(double value) {
+	double cm = std::floor(value * 100.0 + 0.5);
+	cm = std::min(std::max(cm, (double)std::numeric_limits<int32_t>::min()), (double)std::numeric_limits<int32_t>::max());
+	return (int32_t)cm;
+}
+
+/**
+ * @brief Round an offset to decimeters, saturating at the int16 range (+-3276.7 m)
+ * @date Feb 19, 2024
+ */
+static int16_t EncodeDecimeters(double offset) {
+	double dm = std::floor(offset * 10.0 + 0.5);
+	dm = std::min(std::max(dm, (double)std::numeric_limits<int16_t>::min()), (double)std::numeric_limits<int16_t>::max());
+	return (int16_t)dm;
+}
+
+/**
+ * @brief Position as the receiver decodes it
+ * @date Feb 19, 2024
+ *
+ * @param position Exact position
+ * @param encoding Position encoding
+ * @param origin Decoded sender position, offsets of relative NL entries start from it
+ * @param entry True for a NL entry, false for the sender position
+ */
+static Vector QuantizePosition(Vector position, MyTag::PositionEncoding encoding, Vector origin, bool entry) {
+	if (encoding == MyTag::POSITION_CENTIMETERS || (encoding == MyTag::POSITION_RELATIVE && !entry)) {
+		return Vector(EncodeCentimeters(position.x) / 100.0, EncodeCentimeters(position.y) / 100.0,
+		              EncodeCentimeters(position.z) / 100.0);
+	}
+	if (encoding == MyTag::POSITION_RELATIVE) {
+		return Vector(origin.x + EncodeDecimeters(position.x - origin.x) / 10.0,
+		              origin.y + EncodeDecimeters(position.y - origin.y) / 10.0,
+		              origin.z + EncodeDecimeters(position.z - origin.z) / 10.0);
+	}
+	return position;
+}
+
+/**
+ * @brief Write one position in the tag buffer
+ * @date Feb 19, 2024
+ */
+static void WritePosition(TagBuffer &i, MyTag::PositionEncoding encoding, double x, double y, double z,
+                          Vector origin, bool entry) {
+	if (encoding == MyTag::POSITION_CENTIMETERS || (encoding == MyTag::POSITION_RELATIVE && !entry)) {
+		i.WriteU32((uint32_t)EncodeCentimeters(x));
+		i.WriteU32((uint32_t)EncodeCentimeters(y));
+		i.WriteU32((uint32_t)EncodeCentimeters(z));
+	} else if (encoding == MyTag::POSITION_RELATIVE) {
+		i.WriteU16((uint16_t)EncodeDecimeters(x - origin.x));
+		i.WriteU16((uint16_t)EncodeDecimeters(y - origin.y));
+		i.WriteU16((uint16_t)EncodeDecimeters(z - origin.z));
+	} else {
+		i.WriteDouble(x);
+		i.WriteDouble(y);
+		i.WriteDouble(z);
+	}
+}
+
+/**
+ * @brief Read one position from the tag buffer
+ * @date Feb 19, 2024
+ */
+static void ReadPosition(TagBuffer &i, MyTag::PositionEncoding encoding, double &x, double &y, double &z,
+                         Vector origin, bool entry) {
+	if (encoding == MyTag::POSITION_CENTIMETERS || (encoding == MyTag::POSITION_RELATIVE && !entry)) {
+		x = (int32_t)i.ReadU32() / 100.0;
+		y = (int32_t)i.ReadU32() / 100.0;
+		z = (int32_t)i.ReadU32() / 100.0;
+	} else if (encoding == MyTag::POSITION_RELATIVE) {
+		x = origin.x + (int16_t)i.ReadU16() / 10.0;
+		y = origin.y + (int16_t)i.ReadU16() / 10.0;
+		z = origin.z + (int16_t)i.ReadU16() / 10.0;
+	} else {
+		x = i.ReadDouble();
+		y = i.ReadDouble();
+		z = i.ReadDouble();
+	}
+}
+
 /**
  * @brief Get size of serialized data
  * @date Nov 10, 2022
+ * @date Feb 15, 2024 - Exact size of the packed encoding
+ * @date Feb 22, 2024 - Compact alerts
  * @return uint32_t 
  */
 uint32_t MyTag::GetSerializedSize (void) const
 {
-	//return sizeof(Vector) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(vector<NeighInfos>);
-	return sizeof(Vector) + sizeof(uint8_t) + sizeof(uint32_t) + (sizeof(NeighInfos) * m_nNeighborsValue) + sizeof(double);
+	if (m_alertList) {
+		// value + encoding + time + position + entries count + entries (ip, position and state)
+		return 1 + 1 + 8 + GetPositionWireSize(POSITION_RELATIVE, false) + 1
+		       + (ALERT_WIRE_SIZE + GetPositionWireSize(POSITION_RELATIVE, true)) * GetAlertEntries(m_neighInfosVector.size());
+	}
+	// value + encoding + time + number of neighbors + position + entries count + entries
+	return 1 + 1 + 8 + 4 + GetPositionWireSize(m_positionEncoding, false) + 4
+	       + (NEIGH_INFOS_WIRE_SIZE + GetPositionWireSize(m_positionEncoding, true)) * m_neighInfosVector.size();
 }
 
 
@@ -46,37 +218,52 @@ uint32_t MyTag::GetSerializedSize (void) const
  * @brief Serialize tag value and nodes position. The order of how you do Serialize() should match the order of Deserialize()
  * @date Nov 10, 2022 (Created)
  * @date Jan 19, 2023 (Everaldo - Include neigbhors list copy)
+ * @date Feb 15, 2024 - Neighbors written field by field, without struct padding
+ * @date Feb 19, 2024 - Positions written with the tag position encoding
+ * @date Feb 20, 2024 - Delta NL flag in the encoding byte
+ * @date Feb 21, 2024 - Age of each entry
+ * @date Feb 22, 2024 - Compact alerts: suspects ip, position and state only
+ * @date Feb 25, 2024 - Trap targets marked in the entries state
  * 
  * @param i Tag data buffer
  */
 void MyTag::Serialize (TagBuffer i) const
 {	
+	PositionEncoding encoding = GetWireEncoding(m_positionEncoding, m_alertList);
 
 	i.WriteU8(m_simpleValue); // Store tag value first
+	i.WriteU8((uint8_t)encoding | (m_deltaList ? DELTA_LIST_FLAG : 0) | (m_alertList ? ALERT_LIST_FLAG : 0)
+	          | (HasTrapTargets() ? TRAP_TARGETS_FLAG : 0)); // Store how positions and NL are written
 	i.WriteDouble(m_messageTime); // Store message sent time 
-	i.WriteU32(m_nNeighborsValue); // Store number of neighbors value
-	i.WriteDouble (m_currentPosition.x); // Store the position
-	i.WriteDouble (m_currentPosition.y);
-	i.WriteDouble (m_currentPosition.z);
-
-	// Array application
-	struct NeighInfos nInfos[m_nNeighborsValue];
-	uint16_t j = 0;
-
-	for(auto n :m_neighInfosVector){
-		nInfos[j].ip = n.ip;
-		nInfos[j].x = n.x;
-		nInfos[j].y = n.y;
-		nInfos[j].z = n.z; 
-		nInfos[j].hop = n.hop;
-		nInfos[j].state = n.state;
-		j+=1;
+	if (!m_alertList) {
+		i.WriteU32(m_nNeighborsValue); // Store number of neighbors value
+	}
+	Vector origin = QuantizePosition(m_currentPosition, encoding, Vector(), false);
+	WritePosition(i, encoding, m_currentPosition.x, m_currentPosition.y, m_currentPosition.z, origin, false);
+
+	if (m_alertList) {
+		// The notifier is the packet source and the alert is as fresh as
+		// the message, so only the suspects themselves are written
+		uint32_t nEntries = GetAlertEntries(m_neighInfosVector.size());
+		i.WriteU8((uint8_t)nEntries);
+		for (uint32_t n = 0; n < nEntries; n++) {
+			const NeighInfos &entry = m_neighInfosVector[n];
+			i.WriteU32(entry.ip.Get());
+			WritePosition(i, encoding, entry.x, entry.y, entry.z, origin, true);
+			i.WriteU8(entry.state);
+		}
+		return;
 	}
-	
-	unsigned char temp3[sizeof(NeighInfos) * m_nNeighborsValue];
-	std::memcpy(temp3,nInfos,sizeof(NeighInfos) * m_nNeighborsValue);
 
-	i.Write(temp3,sizeof(NeighInfos) * m_nNeighborsValue);
+	// Entries really carried, the NL may have changed since SetNNeighbors
+	i.WriteU32((uint32_t)m_neighInfosVector.size());
+	for (vector<NeighInfos>::const_iterator n = m_neighInfosVector.begin(); n != m_neighInfosVector.end(); n++) {
+		i.WriteU32(n->ip.Get());
+		WritePosition(i, encoding, n->x, n->y, n->z, origin, true);
+		i.WriteU8(n->hop);
+		i.WriteU8(n->state | (IsTrapTarget(n->ip) ? TRAP_TARGET_STATE : 0));
+		i.WriteU16(EncodeInfoAge(m_messageTime, n->infoTime));
+	}
 }
 
 
@@ -85,37 +272,58 @@ void MyTag::Serialize (TagBuffer i) const
  * @date Nov 10, 2022
  * @date Jan 19, 2023 (Everaldo - Include neigbhors list copy)
  * @date Jun 05, 2023 - Include message sent time to tag
+ * @date Feb 15, 2024 - Neighbors read field by field
+ * @date Feb 19, 2024 - Positions read with the tag position encoding
+ * @date Feb 20, 2024 - Delta NL flag in the encoding byte
+ * @date Feb 21, 2024 - Age of each entry, back to a time on the sender clock
+ * @date Feb 22, 2024 - Compact alerts, entries one hop from the notifier
+ * @date Feb 25, 2024 - Trap targets taken from the entries state
  * 
  * @param i Tag data buffer
  */
 void MyTag::Deserialize (TagBuffer i)
 {
 	m_simpleValue = i.ReadU8(); // Extract what we stored first, so we extract the tag value
+	uint8_t format = i.ReadU8(); // Extract how positions and NL are written
+	m_positionEncoding = (PositionEncoding)(format & ~(DELTA_LIST_FLAG | ALERT_LIST_FLAG | TRAP_TARGETS_FLAG));
+	m_deltaList = (format & DELTA_LIST_FLAG) != 0;
+	m_alertList = (format & ALERT_LIST_FLAG) != 0;
+	m_trapTargets.clear();
 	m_messageTime = i.ReadDouble(); // Extract the time message was sent
-	m_nNeighborsValue = i.ReadU32(); // Extract the number of neighobrs value
-	m_currentPosition.x = i.ReadDouble(); // Extract position
-	m_currentPosition.y = i.ReadDouble();
-	m_currentPosition.z = i.ReadDouble();
-
-	// Arrarys application
-	struct NeighInfos nInfos[m_nNeighborsValue];
-	
-	unsigned char temp3[sizeof(NeighInfos) * m_nNeighborsValue];
-	i.Read(temp3,sizeof(NeighInfos) * m_nNeighborsValue);	
-	memcpy(&nInfos,&temp3,sizeof(NeighInfos) * m_nNeighborsValue);
-
-	m_neighInfosVector.clear();
+	if (!m_alertList) {
+		m_nNeighborsValue = i.ReadU32(); // Extract the number of neighobrs value
+	}
+	ReadPosition(i, m_positionEncoding, m_currentPosition.x, m_currentPosition.y, m_currentPosition.z, Vector(), false);
+
+	if (m_alertList) {
+		m_nNeighborsValue = i.ReadU8();
+		m_neighInfosVector.resize(m_nNeighborsValue);
+		for (vector<NeighInfos>::iterator n = m_neighInfosVector.begin(); n != m_neighInfosVector.end(); n++) {
+			n->ip.Set(i.ReadU32());
+			ReadPosition(i, m_positionEncoding, n->x, n->y, n->z, m_currentPosition, true);
+			n->hop = 1; // Suspects are neighbors of the notifier
+			n->state = i.ReadU8();
+			n->infoTime = m_messageTime;
+		}
+		return;
+	}
 
-	for(auto n :nInfos){
-		NeighInfos node;
-		node.ip = n.ip;
-		node.x = n.x;
-		node.y = n.y;
-		node.z = n.z;
-		node.hop = n.hop;
-		node.state = n.state;
-		m_neighInfosVector.push_back(node);
+	// Read straight into the vector, sized once - Feb 16, 24
+	uint32_t nEntries = i.ReadU32();
+	m_neighInfosVector.resize(nEntries);
+
+	for (vector<NeighInfos>::iterator n = m_neighInfosVector.begin(); n != m_neighInfosVector.end(); n++) {
+		n->ip.Set(i.ReadU32());
+		ReadPosition(i, m_positionEncoding, n->x, n->y, n->z, m_currentPosition, true);
+		n->hop = i.ReadU8();
+		n->state = i.ReadU8();
+		n->infoTime = m_messageTime - i.ReadU16() / 100.0;
+		if ((format & TRAP_TARGETS_FLAG) && (n->state & TRAP_TARGET_STATE)) {
+			m_trapTargets.push_back(n->ip);
+		}
+		n->state &= ~TRAP_TARGET_STATE;
 	}
+	std::sort(m_trapTargets.begin(), m_trapTargets.end());
 }
 
 void MyTag::Print(std::ostream &os) const {
@@ -148,7 +356,7 @@ uint8_t MyTag::GetSimpleValue(void) const
  * 
  * @return Vector with position values
  */
-Vector MyTag::GetPosition(void) {
+Vector MyTag::GetPosition(void) const {
 	return m_currentPosition;
 }
 
@@ -168,7 +376,7 @@ void MyTag::SetPosition(Vector pos) {
  * 
  * @return uint32_t Number of neighbor nodes
  */
-uint32_t MyTag::GetNNeighbors(void){
+uint32_t MyTag::GetNNeighbors(void) const{
 	return m_nNeighborsValue;
 }
 
@@ -187,24 +395,50 @@ void MyTag::SetNNeighbors (uint32_t nNeighbors){
 /**
  * @brief Get neighbor list vector from tag
  * @date 19012023
+ * @date Feb 21, 2024 - Returned by reference, valid while the tag lives
  * 
  * @return const vector<MyTag::NodeInfos>& 
  */
-vector<MyTag::NeighInfos> MyTag::GetNeighInfosVector() const {
+const vector<MyTag::NeighInfos> &MyTag::GetNeighInfosVector() const {
 	return m_neighInfosVector;
 }
 
 
+/**
+ * @brief Move the neighbor list vector out of the tag, without copy.
+ * The tag NL is left empty.
+ * @date Feb 21, 2024
+ * 
+ * @return vector<MyTag::NodeInfos> Neighbor nodes list of the tag
+ */
+vector<MyTag::NeighInfos> MyTag::TakeNeighInfosVector() {
+	vector<MyTag::NeighInfos> neighInfosVector;
+	neighInfosVector.swap(m_neighInfosVector);
+	return neighInfosVector;
+}
+
+
 /**
  * @brief Set a neighbor list vector in the tag
  * @date 19012023
  * 
  * @param NodeInfosVector Vector with a neighbor nodes list
  */
-void MyTag::SetNeighInfosVector(const vector<MyTag::NeighInfos> neighInfosVector) {
+void MyTag::SetNeighInfosVector(const vector<MyTag::NeighInfos> &neighInfosVector) {
 	m_neighInfosVector = neighInfosVector;
 }
 
+
+/**
+ * @brief Move a neighbor list vector in the tag, without copy
+ * @date Feb 21, 2024
+ * 
+ * @param NodeInfosVector Vector with a neighbor nodes list, left empty
+ */
+void MyTag::SetNeighInfosVector(vector<MyTag::NeighInfos> &&neighInfosVector) {
+	m_neighInfosVector = std::move(neighInfosVector);
+}
+
 /**
  * @brief Set message time to tag
  * @date 05062023
@@ -221,11 +455,229 @@ void MyTag::SetMessageTime(double time){
  * 
  * @return time Double message sent time
  */
-double MyTag::GetMessageTime(){
+double MyTag::GetMessageTime() const{
  	return m_messageTime;
 }
 
 
+/**
+ * @brief Set how positions are written in the tag
+ * @date Feb 19, 2024
+ * 
+ * @param encoding Position encoding
+ */
+void MyTag::SetPositionEncoding(PositionEncoding encoding){
+ 	m_positionEncoding = encoding;
+}
+
+/**
+ * @brief Get how positions are written in the tag
+ * @date Feb 19, 2024
+ * 
+ * @return PositionEncoding Position encoding
+ */
+MyTag::PositionEncoding MyTag::GetPositionEncoding(void) const{
+ 	return m_positionEncoding;
+}
+
+/**
+ * @brief Get the largest distance between a position set in the tag and
+ * the position the receiver will decode
+ * @date Feb 19, 2024
+ * 
+ * @return double Quantization error (m), 0 for POSITION_DOUBLE
+ */
+double MyTag::GetQuantizationError(void) const{
+	PositionEncoding encoding = GetWireEncoding(m_positionEncoding, m_alertList);
+	Vector origin = QuantizePosition(m_currentPosition, encoding, Vector(), false);
+	double error = CalculateDistance(m_currentPosition, origin);
+	for (vector<NeighInfos>::const_iterator n = m_neighInfosVector.begin(); n != m_neighInfosVector.end(); n++) {
+		Vector position(n->x, n->y, n->z);
+		error = std::max(error, CalculateDistance(position, QuantizePosition(position, encoding, origin, true)));
+	}
+	return error;
+}
+
+
+/**
+ * @brief Set whether the NL in the tag carries only the entries changed
+ * since the NL previously sent to the same neighbor
+ * @date Feb 20, 2024
+ * 
+ * @param delta True for a delta NL, false for the full NL
+ */
+void MyTag::SetDeltaList(bool delta){
+ 	m_deltaList = delta;
+}
+
+/**
+ * @brief Get whether the NL in the tag carries only changed entries
+ * @date Feb 20, 2024
+ * 
+ * @return true - delta NL
+ * @return false - full NL
+ */
+bool MyTag::IsDeltaList(void) const{
+ 	return m_deltaList;
+}
+
+/**
+ * @brief Set whether the NL in the tag is sent as a compact alert: the
+ * suspects ip, relative position and state, without the NL fields
+ * @date Feb 22, 2024
+ * 
+ * @param alert True for an alert, false for a NL
+ */
+void MyTag::SetAlertList(bool alert){
+ 	m_alertList = alert;
+}
+
+/**
+ * @brief Get whether the NL in the tag is sent as a compact alert
+ * @date Feb 22, 2024
+ * 
+ * @return true - alert
+ * @return false - NL
+ */
+bool MyTag::IsAlertList(void) const{
+ 	return m_alertList;
+}
+
+/**
+ * @brief Set the nodes a message broadcast to the neighborhood is for.
+ * They are marked in their NL entries, nodes out of the NL cannot be
+ * targets. An empty list sends the message to every receiver.
+ * @date Feb 25, 2024
+ * 
+ * @param targets Target nodes, sorted
+ */
+void MyTag::SetTrapTargets(const vector<Ipv4Address> &targets){
+ 	m_trapTargets = targets;
+}
+
+/**
+ * @brief Get whether the message is for some nodes only
+ * @date Feb 25, 2024
+ * 
+ * @return true - only the targets handle the message
+ * @return false - every receiver handles the message
+ */
+bool MyTag::HasTrapTargets(void) const{
+ 	return !m_trapTargets.empty() && !m_alertList;
+}
+
+/**
+ * @brief Get whether a node is one of the message targets
+ * @date Feb 25, 2024
+ * 
+ * @param ip Node IPv4 address
+ * @return true - the node is a target
+ * @return false - the node is not a target, or the message has no targets
+ */
+bool MyTag::IsTrapTarget(Ipv4Address ip) const{
+ 	return std::binary_search(m_trapTargets.begin(), m_trapTargets.end(), ip);
+}
+
+/**
+ * @brief Get the size of the tag written in some bytes, from its header
+ * fields only. Lets a reader check a tag is whole before deserializing it.
+ * @date Feb 25, 2024
+ * 
+ * @param bytes Serialized tag
+ * @param size Bytes available
+ * @return uint32_t Tag size, 0 if the bytes do not hold a whole tag
+ */
+uint32_t MyTag::GetWireSize(const uint8_t *bytes, uint32_t size){
+	if (size < 2) {
+		return 0;
+	}
+	uint8_t format = bytes[1];
+	PositionEncoding encoding = (PositionEncoding)(format & ~(DELTA_LIST_FLAG | ALERT_LIST_FLAG | TRAP_TARGETS_FLAG));
+	bool alert = (format & ALERT_LIST_FLAG) != 0;
+	if (encoding > POSITION_RELATIVE || encoding != GetWireEncoding(encoding, alert)) {
+		return 0;
+	}
+
+	// value + encoding + time + number of neighbors + position, then the entries count
+	uint32_t head = 1 + 1 + 8 + (alert ? 0 : 4) + GetPositionWireSize(encoding, false);
+	uint32_t countSize = alert ? 1 : 4;
+	if (size < head + countSize) {
+		return 0;
+	}
+	uint8_t *start = const_cast<uint8_t *>(bytes) + head;
+	TagBuffer i(start, start + countSize);
+	uint64_t nEntries = alert ? i.ReadU8() : i.ReadU32();
+	uint64_t entrySize = (alert ? ALERT_WIRE_SIZE : NEIGH_INFOS_WIRE_SIZE) + GetPositionWireSize(encoding, true);
+	uint64_t total = head + countSize + nEntries * entrySize;
+	return total > size ? 0 : (uint32_t)total;
+}
+
+/**
+ * @brief Get the most NL entries a tag of some bytes can carry
+ * @date Feb 25, 2024
+ * 
+ * @param encoding Position encoding
+ * @param size Bytes available
+ * @return uint32_t Most entries of a NL that is not an alert
+ */
+uint32_t MyTag::GetMaxNeighInfos(PositionEncoding encoding, uint32_t size){
+	// value + encoding + time + number of neighbors + position + entries count
+	uint32_t head = 1 + 1 + 8 + 4 + GetPositionWireSize(encoding, false) + 4;
+	if (size < head) {
+		return 0;
+	}
+	return (size - head) / (NEIGH_INFOS_WIRE_SIZE + GetPositionWireSize(encoding, true));
+}
+
+/**
+ * @brief Get the NL entries added or changed from one NL to another.
+ * Both NL are sorted by IP, so they are compared in a single pass.
+ * @date Feb 20, 2024
+ * @date Feb 25, 2024 - Entries heard again long after the time sent are changed
+ * 
+ * An entry only heard again keeps the time it was sent with in known, so
+ * the shift of its time adds up round after round until it is sent.
+ * 
+ * @param previous NL sent before, sorted by IP
+ * @param current NL to send, sorted by IP
+ * @param maxInfoShift Entries heard more than this after their time in
+ * previous are changed too (s), 0 ignores the information time
+ * @param known If not null, receives the NL the receivers have after the
+ * changes, sorted by IP: changed entries from current, others from previous
+ * @return vector<MyTag::NeighInfos> Entries of current not in previous, or
+ * with other position, hop or state, in IP order
+ */
+vector<MyTag::NeighInfos> MyTag::GetChangedNeighInfos(const vector<NeighInfos> &previous,
+                                                      const vector<NeighInfos> &current,
+                                                      double maxInfoShift,
+                                                      vector<NeighInfos> *known){
+	vector<NeighInfos> changed;
+	vector<NeighInfos>::const_iterator p = previous.begin();
+
+	if (known) {
+		known->clear();
+		known->reserve(current.size());
+	}
+	for (vector<NeighInfos>::const_iterator n = current.begin(); n != current.end(); n++) {
+		while (p != previous.end() && p->ip < n->ip) {
+			p++; // Entry removed since the previous NL
+		}
+		if (p == previous.end() || !(p->ip == n->ip) || p->x != n->x || p->y != n->y
+		    || p->z != n->z || p->hop != n->hop || p->state != n->state
+		    || (maxInfoShift > 0 && n->infoTime - p->infoTime > maxInfoShift)) {
+			changed.push_back(*n);
+			if (known) {
+				known->push_back(*n);
+			}
+		}
+		else if (known) {
+			known->push_back(*p); // Receivers keep the time sent before
+		}
+	}
+	return changed;
+}
+
+
 }  // namespace ns3
 
 /* ------------------------------------------------------------------------
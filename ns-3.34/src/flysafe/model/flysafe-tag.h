@@ -5,6 +5,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/vector.h"
 #include "ns3/ipv4.h"
+#include "ns3/neighbor-snapshot.h"
 
 using namespace std;
 
@@ -12,6 +13,17 @@ namespace ns3 {
 
 class MyTag : public Tag {
 public:
+  /**
+   * \brief How positions are written in the tag
+   * @date Feb 19, 2024
+   */
+  enum PositionEncoding {
+        POSITION_DOUBLE = 0,      //!< x, y, z as doubles (24 bytes)
+        POSITION_CENTIMETERS = 1, //!< x, y, z as int32 centimeters (12 bytes)
+        POSITION_RELATIVE = 2     //!< Own position in centimeters, NL entries as int16 decimeter offsets from it (6 bytes)
+  };
+
+  MyTag();
   static TypeId GetTypeId(void);
   virtual TypeId GetInstanceTypeId(void) const;
   virtual uint32_t GetSerializedSize(void) const;
@@ -22,16 +34,30 @@ public:
   uint8_t GetSimpleValue(void) const;
 
   //These are custom accessor
-	Vector GetPosition(void);                     //!< Get nodes position
+	Vector GetPosition(void) const;               //!< Get nodes position
 	void SetPosition (Vector pos);                //!< Set nodes position
-	uint32_t GetNNeighbors(void);                 //!< Get the number of neighbor nodes
+	uint32_t GetNNeighbors(void) const;           //!< Get the number of neighbor nodes
 	void SetNNeighbors (uint32_t nNeighbors);     //!< Set the number of neighbor nodes
   void SetMessageTime(double time);             //!< Set message sent time to tag
-  double GetMessageTime();                      //!< Get message sent time to tag
+  double GetMessageTime() const;                //!< Get message sent time to tag
+  void SetPositionEncoding(PositionEncoding encoding); //!< Set how positions are written
+  PositionEncoding GetPositionEncoding(void) const;    //!< Get how positions are written
+  double GetQuantizationError(void) const;      //!< Largest position error due to the encoding (m)
+  void SetDeltaList(bool delta);                //!< Set whether the NL carries only changed entries
+  bool IsDeltaList(void) const;                 //!< Get whether the NL carries only changed entries
+  void SetAlertList(bool alert);                //!< Set whether the NL is sent as a compact alert
+  bool IsAlertList(void) const;                 //!< Get whether the NL is sent as a compact alert
+  void SetTrapTargets(const vector<Ipv4Address> &targets); //!< Set the NL entries a broadcast is for, sorted
+  bool HasTrapTargets(void) const;              //!< Get whether the message is for some NL entries only
+  bool IsTrapTarget(Ipv4Address ip) const;      //!< Get whether the message is for a node
+
+  /// Most entries carried by one alert
+  static const uint32_t MAX_ALERT_ENTRIES = 255;
 
   /**
    * @brief Struct to store infos from a neighbor node
    * @date 19012023
+   * @date Feb 21, 2024 - Time of the information, sent as its age
    */
   struct NeighInfos {
         Ipv4Address ip;
@@ -40,23 +66,18 @@ public:
         double z;
         uint8_t hop;
         uint8_t state;
+        double infoTime;  //!< Time the sender last heard the node (s)
   };
 
   /**
    * \brief Neighbor entry.
    * This structure is used to store Neighbors' node information
    * @date 06042023
+   *
+   * Same entry as the FlySafe NL, so NL snapshots are traced without
+   * conversion - Feb 1, 2024
    */
-
-  struct NeighborFull {
-        Ipv4Address ip; //!< the neighbor IP address
-        Vector position;
-        double distance;
-        uint8_t attitude;
-        uint8_t quality;
-        uint8_t hop; //!< hop = 1 means neighbor in range, 
-        uint8_t state; // !< 0 ordinary, 1 suspicious
-  }; 
+  typedef FlySafeNeighborTable::Neighbor NeighborFull;
 
   /**
    * \brief Malicious Neighbor entry
@@ -70,8 +91,48 @@ public:
         std::vector<Ipv4Address> notifyIP;
   }; 
 
-  vector<NeighInfos> GetNeighInfosVector() const;
-	void SetNeighInfosVector(const vector<NeighInfos> neighInfosVector);
+  const vector<NeighInfos> &GetNeighInfosVector() const;       //!< NL in the tag, without copy
+  vector<NeighInfos> TakeNeighInfosVector();                   //!< Move the NL out, leaving the tag NL empty
+	void SetNeighInfosVector(const vector<NeighInfos> &neighInfosVector); //!< Copy a NL to the tag
+	void SetNeighInfosVector(vector<NeighInfos> &&neighInfosVector);      //!< Move a NL to the tag
+
+  /**
+   * \brief Get the NL entries added or changed from one NL to another
+   * @date Feb 20, 2024
+   * @date Feb 25, 2024 - Entries heard again long after the time sent are changed
+   *
+   * \param previous NL sent before, sorted by IP
+   * \param current NL to send, sorted by IP
+   * \param maxInfoShift entries heard more than this after the time in previous
+   * are changed too (s), 0 ignores the information time
+   * \param known if not null, receives the NL the receivers have after the
+   * changes, sorted by IP: the next previous
+   * \return entries of current not in previous or with other position, hop or state
+   */
+  static vector<NeighInfos> GetChangedNeighInfos(const vector<NeighInfos> &previous,
+                                                 const vector<NeighInfos> &current,
+                                                 double maxInfoShift = 0,
+                                                 vector<NeighInfos> *known = 0);
+
+  /**
+   * \brief Get the size of the tag written in some bytes, before reading it
+   * @date Feb 25, 2024
+   *
+   * \param bytes serialized tag
+   * \param size bytes available
+   * \return the tag size, 0 if the bytes do not hold a whole tag
+   */
+  static uint32_t GetWireSize(const uint8_t *bytes, uint32_t size);
+
+  /**
+   * \brief Get the most NL entries a tag of some bytes can carry
+   * @date Feb 25, 2024
+   *
+   * \param encoding position encoding
+   * \param size bytes available
+   * \return the most entries of a NL that is not an alert
+   */
+  static uint32_t GetMaxNeighInfos(PositionEncoding encoding, uint32_t size);
 
 private:
   uint8_t m_simpleValue;                  //!< Tag value
@@ -79,6 +140,10 @@ private:
 	Vector m_currentPosition;               //!< Current position
   vector<NeighInfos> m_neighInfosVector;  //!< Store a list of neighbor nodes infos
   double m_messageTime;                   //!< Store message sent time
+  PositionEncoding m_positionEncoding;    //!< Store how positions are written
+  bool m_deltaList;                       //!< Store whether the NL carries only changed entries
+  bool m_alertList;                       //!< Store whether the NL is sent as a compact alert
+  vector<Ipv4Address> m_trapTargets;      //!< Store the NL entries the message is for, sorted
 };
 } // namespace ns3
 
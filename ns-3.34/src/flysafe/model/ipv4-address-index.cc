@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include "ipv4-address-index.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/// Number of buckets allocated on the first insertion
+static const uint32_t INDEX_MIN_BUCKETS = 16;
+
+const uint32_t Ipv4AddressIndex::NOT_FOUND;
+
+Ipv4AddressIndex::Ipv4AddressIndex ()
+  : m_mask (0),
+    m_size (0)
+{
+}
+
+uint32_t
+Ipv4AddressIndex::Hash (uint32_t key) const
+{
+  // Addresses of a simulation share their prefix and differ in the low
+  // bits, so mix all bits before masking (murmur3 finalizer).
+  key ^= key >> 16;
+  key *= 0x85ebca6b;
+  key ^= key >> 13;
+  key *= 0xc2b2ae35;
+  key ^= key >> 16;
+  return key & m_mask;
+}
+
+uint32_t
+Ipv4AddressIndex::Find (Ipv4Address address) const
+{
+  if (m_size == 0)
+    {
+      return NOT_FOUND;
+    }
+  uint32_t key = address.Get ();
+  for (uint32_t b = Hash (key); ; b = (b + 1) & m_mask)
+    {
+      const Bucket &bucket = m_buckets[b];
+      if (bucket.value == NOT_FOUND)
+        {
+          return NOT_FOUND;
+        }
+      if (bucket.key == key)
+        {
+          return bucket.value;
+        }
+    }
+}
+
+void
+Ipv4AddressIndex::Insert (Ipv4Address address, uint32_t value)
+{
+  NS_ASSERT (value != NOT_FOUND);
+  if ((m_size + 1) * 2 > m_buckets.size ())
+    {
+      Rehash (m_buckets.empty () ? INDEX_MIN_BUCKETS : 2 * m_buckets.size ());
+    }
+  uint32_t key = address.Get ();
+  for (uint32_t b = Hash (key); ; b = (b + 1) & m_mask)
+    {
+      Bucket &bucket = m_buckets[b];
+      if (bucket.value == NOT_FOUND)
+        {
+          bucket.key = key;
+          bucket.value = value;
+          m_size++;
+          return;
+        }
+      if (bucket.key == key)
+        {
+          bucket.value = value;
+          return;
+        }
+    }
+}
+
+bool
+Ipv4AddressIndex::Erase (Ipv4Address address)
+{
+  if (m_size == 0)
+    {
+      return false;
+    }
+  uint32_t key = address.Get ();
+  uint32_t hole = Hash (key);
+  while (m_buckets[hole].key != key || m_buckets[hole].value == NOT_FOUND)
+    {
+      if (m_buckets[hole].value == NOT_FOUND)
+        {
+          return false;
+        }
+      hole = (hole + 1) & m_mask;
+    }
+
+  // Backward-shift deletion: pull back every following entry of the
+  // probe run that may legally occupy the hole.
+  for (uint32_t b = (hole + 1) & m_mask; m_buckets[b].value != NOT_FOUND; b = (b + 1) & m_mask)
+    {
+      uint32_t home = Hash (m_buckets[b].key);
+      if (((b - home) & m_mask) >= ((b - hole) & m_mask))
+        {
+          m_buckets[hole] = m_buckets[b];
+          hole = b;
+        }
+    }
+  m_buckets[hole].value = NOT_FOUND;
+  m_size--;
+  return true;
+}
+
+void
+Ipv4AddressIndex::Clear (void)
+{
+  for (std::vector<Bucket>::iterator i = m_buckets.begin (); i != m_buckets.end (); i++)
+    {
+      i->value = NOT_FOUND;
+    }
+  m_size = 0;
+}
+
+void
+Ipv4AddressIndex::Reserve (uint32_t n)
+{
+  uint32_t nBuckets = m_buckets.empty () ? INDEX_MIN_BUCKETS : m_buckets.size ();
+  while (n * 2 > nBuckets)
+    {
+      nBuckets *= 2;
+    }
+  if (nBuckets != m_buckets.size ())
+    {
+      Rehash (nBuckets);
+    }
+}
+
+uint32_t
+Ipv4AddressIndex::GetSize (void) const
+{
+  return m_size;
+}
+
+void
+Ipv4AddressIndex::Rehash (uint32_t nBuckets)
+{
+  std::vector<Bucket> old;
+  old.swap (m_buckets);
+  Bucket empty;
+  empty.key = 0;
+  empty.value = NOT_FOUND;
+  m_buckets.assign (nBuckets, empty);
+  m_mask = nBuckets - 1;
+  for (std::vector<Bucket>::const_iterator i = old.begin (); i != old.end (); i++)
+    {
+      if (i->value == NOT_FOUND)
+        {
+          continue;
+        }
+      uint32_t b = Hash (i->key);
+      while (m_buckets[b].value != NOT_FOUND)
+        {
+          b = (b + 1) & m_mask;
+        }
+      m_buckets[b] = *i;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef IPV4_ADDRESS_INDEX_H
+#define IPV4_ADDRESS_INDEX_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Open-addressing hash index from an IPv4 address to a slot number.
+ *
+ * The index stores the 32-bit address value as key and a caller-defined
+ * 32-bit value (usually the position of the entry in a contiguous
+ * container). Collisions are resolved with linear probing and removals
+ * use backward-shift deletion, so lookups never walk over tombstones.
+ * The table is kept at most half full.
+ */
+class Ipv4AddressIndex
+{
+public:
+  /// Value returned by Find when the address is not indexed
+  static const uint32_t NOT_FOUND = 0xffffffff;
+
+  Ipv4AddressIndex ();
+
+  /**
+   * \brief Look up an address
+   * \param address the address to look for
+   * \returns the value associated to the address or NOT_FOUND
+   */
+  uint32_t Find (Ipv4Address address) const;
+
+  /**
+   * \brief Associate a value to an address, replacing any previous value
+   * \param address the address to index
+   * \param value the value to associate (must not be NOT_FOUND)
+   */
+  void Insert (Ipv4Address address, uint32_t value);
+
+  /**
+   * \brief Remove an address from the index
+   * \param address the address to remove
+   * \returns true if the address was indexed
+   */
+  bool Erase (Ipv4Address address);
+
+  /**
+   * \brief Remove all addresses, keeping the allocated buckets
+   */
+  void Clear (void);
+
+  /**
+   * \brief Make room for at least n addresses without rehashing
+   * \param n expected number of addresses
+   */
+  void Reserve (uint32_t n);
+
+  /**
+   * \returns the number of indexed addresses
+   */
+  uint32_t GetSize (void) const;
+
+private:
+  /// A bucket of the table
+  struct Bucket
+  {
+    uint32_t key;   //!< IPv4 address value
+    uint32_t value; //!< associated value, NOT_FOUND when empty
+  };
+
+  /**
+   * \param key IPv4 address value
+   * \returns the home bucket of the key
+   */
+  uint32_t Hash (uint32_t key) const;
+
+  /**
+   * \brief Rebuild the table with a new number of buckets
+   * \param nBuckets new number of buckets (power of two)
+   */
+  void Rehash (uint32_t nBuckets);
+
+  std::vector<Bucket> m_buckets; //!< the buckets
+  uint32_t m_mask;               //!< number of buckets minus one
+  uint32_t m_size;               //!< number of indexed addresses
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ADDRESS_INDEX_H */
@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include "ns3/assert.h"
+#include "ipv4-address-interner.h"
+
+namespace ns3 {
+
+const uint32_t Ipv4AddressInterner::NOT_FOUND;
+
+uint32_t
+Ipv4AddressInterner::Intern (Ipv4Address address)
+{
+  uint32_t id = m_ids.Find (address);
+  if (id == NOT_FOUND)
+    {
+      id = m_addresses.size ();
+      m_ids.Insert (address, id);
+      m_addresses.push_back (address);
+    }
+  return id;
+}
+
+uint32_t
+Ipv4AddressInterner::Find (Ipv4Address address) const
+{
+  return m_ids.Find (address);
+}
+
+Ipv4Address
+Ipv4AddressInterner::GetAddress (uint32_t id) const
+{
+  NS_ASSERT_MSG (id < m_addresses.size (), "Unknown address id " << id);
+  return m_addresses[id];
+}
+
+Ipv4AddressRange
+Ipv4AddressInterner::GetAddresses (void) const
+{
+  return Ipv4AddressRange (m_addresses);
+}
+
+uint32_t
+Ipv4AddressInterner::GetN (void) const
+{
+  return m_addresses.size ();
+}
+
+void
+Ipv4AddressInterner::Clear (void)
+{
+  m_addresses.clear ();
+  m_ids.Clear ();
+}
+
+} // namespace ns3
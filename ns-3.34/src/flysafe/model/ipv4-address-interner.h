@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef IPV4_ADDRESS_INTERNER_H
+#define IPV4_ADDRESS_INTERNER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-address-index.h"
+#include "ns3/ipv4-address-range.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Dense numbering of IPv4 addresses.
+ *
+ * Every address gets the next free id the first time it is interned,
+ * so ids run from 0 to GetN () - 1 and can index flat arrays and bitsets
+ * (see NodeIdSet). Interning the node addresses at setup, in node list
+ * order, makes the id of a node address equal to its node index.
+ */
+class Ipv4AddressInterner
+{
+public:
+  /// Value returned by Find when the address was never interned
+  static const uint32_t NOT_FOUND = Ipv4AddressIndex::NOT_FOUND;
+
+  /**
+   * \brief Get the id of an address, giving it a new id if needed
+   * \param address the address
+   * \returns the id of the address
+   */
+  uint32_t Intern (Ipv4Address address);
+
+  /**
+   * \param address the address
+   * \returns the id of the address or NOT_FOUND
+   */
+  uint32_t Find (Ipv4Address address) const;
+
+  /**
+   * \param id an id returned by Intern
+   * \returns the address with that id
+   */
+  Ipv4Address GetAddress (uint32_t id) const;
+
+  /// \returns all the interned addresses, ordered by id
+  Ipv4AddressRange GetAddresses (void) const;
+
+  /// \returns the number of interned addresses
+  uint32_t GetN (void) const;
+
+  /// \brief Forget all the addresses
+  void Clear (void);
+
+private:
+  std::vector<Ipv4Address> m_addresses; //!< addresses by id
+  Ipv4AddressIndex m_ids;               //!< address to id
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ADDRESS_INTERNER_H */
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef IPV4_ADDRESS_RANGE_H
+#define IPV4_ADDRESS_RANGE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ipv4-address.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Read-only view over contiguous IPv4 addresses.
+ *
+ * The view does not own the addresses and allocates nothing. It stays
+ * valid until the container it was taken from is modified, so it must
+ * not be kept across calls that add or remove entries.
+ */
+class Ipv4AddressRange
+{
+public:
+  /// Iterator over the addresses
+  typedef const Ipv4Address *const_iterator;
+
+  /// Create an empty range
+  Ipv4AddressRange ()
+    : m_begin (0),
+      m_size (0)
+  {
+  }
+
+  /**
+   * \brief View all the addresses of a vector
+   * \param addresses the viewed vector
+   */
+  Ipv4AddressRange (const std::vector<Ipv4Address> &addresses)
+    : m_begin (addresses.empty () ? 0 : &addresses[0]),
+      m_size (addresses.size ())
+  {
+  }
+
+  /// \returns an iterator to the first address
+  const_iterator begin (void) const
+  {
+    return m_begin;
+  }
+
+  /// \returns an iterator past the last address
+  const_iterator end (void) const
+  {
+    return m_begin + m_size;
+  }
+
+  /// \returns the number of addresses
+  uint32_t size (void) const
+  {
+    return m_size;
+  }
+
+  /// \returns true if there is no address
+  bool empty (void) const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param i the position of the address
+   * \returns the address
+   */
+  const Ipv4Address &operator[] (uint32_t i) const
+  {
+    NS_ASSERT_MSG (i < m_size, "Ipv4AddressRange index " << i << " out of range");
+    return m_begin[i];
+  }
+
+  /// \returns a copy of the addresses
+  std::vector<Ipv4Address> ToVector (void) const
+  {
+    return std::vector<Ipv4Address> (begin (), end ());
+  }
+
+private:
+  const Ipv4Address *m_begin; //!< first address
+  uint32_t m_size;            //!< number of addresses
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ADDRESS_RANGE_H */
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <cstring>
+
+#include "neighbor-scan.h"
+
+namespace ns3 {
+
+namespace NeighborScan {
+
+/// Number of entries handled by one 64-bit word
+static const uint32_t LANES = 8;
+/// 0x01 in every byte
+static const uint64_t ONES = 0x0101010101010101ULL;
+/// 0x7f in every byte
+static const uint64_t LOW7 = 0x7f7f7f7f7f7f7f7fULL;
+/// 0x80 in every byte
+static const uint64_t HIGH = 0x8080808080808080ULL;
+
+/**
+ * \param p first of eight bytes, no alignment required
+ * \returns the bytes as a word
+ */
+static inline uint64_t
+Load (const uint8_t *p)
+{
+  uint64_t word;
+  std::memcpy (&word, p, sizeof (word));
+  return word;
+}
+
+/**
+ * \param word eight bytes
+ * \returns 0x80 in every byte of word that is zero, 0x00 elsewhere
+ *
+ * Unlike the usual (w - 0x01..) & ~w trick this is exact per byte, since
+ * no borrow crosses byte boundaries.
+ */
+static inline uint64_t
+ZeroBytes (uint64_t word)
+{
+  return ~(((word & LOW7) + LOW7) | word | LOW7);
+}
+
+bool
+AnyEqual (const uint8_t *values, uint32_t n, uint8_t value)
+{
+  uint64_t pattern = ONES * value;
+  uint32_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    {
+      if (ZeroBytes (Load (values + i) ^ pattern) != 0)
+        {
+          return true;
+        }
+    }
+  for (; i < n; i++)
+    {
+      if (values[i] == value)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+DecrementNonZero (uint8_t *values, uint32_t n)
+{
+  uint32_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    {
+      uint64_t word = Load (values + i);
+      // 0x01 in every non-zero byte: subtracting it never borrows
+      uint64_t ones = (~ZeroBytes (word) & HIGH) >> 7;
+      word -= ones;
+      std::memcpy (values + i, &word, sizeof (word));
+    }
+  for (; i < n; i++)
+    {
+      values[i] -= (values[i] != 0);
+    }
+}
+
+void
+CollectBothZero (const uint8_t *a, const uint8_t *b, uint32_t n,
+                 std::vector<uint32_t> &positions)
+{
+  uint32_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    {
+      if ((ZeroBytes (Load (a + i)) & ZeroBytes (Load (b + i))) == 0)
+        {
+          continue; // Most words: nothing to collect
+        }
+      for (uint32_t j = i; j < i + LANES; j++)
+        {
+          if (a[j] == 0 && b[j] == 0)
+            {
+              positions.push_back (j);
+            }
+        }
+    }
+  for (; i < n; i++)
+    {
+      if (a[i] == 0 && b[i] == 0)
+        {
+          positions.push_back (i);
+        }
+    }
+}
+
+void
+CollectBelow (const double *values, uint32_t n, double limit,
+              std::vector<uint32_t> &positions)
+{
+  // Branch-free compaction: the store is unconditional and only the
+  // output cursor depends on the comparison, so the loop vectorizes.
+  uint32_t first = positions.size ();
+  positions.resize (first + n);
+  uint32_t *out = n > 0 ? &positions[first] : 0;
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      out[count] = i;
+      count += (values[i] < limit);
+    }
+  positions.resize (first + count);
+}
+
+} // namespace NeighborScan
+
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef NEIGHBOR_SCAN_H
+#define NEIGHBOR_SCAN_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Scan kernels over the columns of the node neighbor table.
+ *
+ * The byte columns (hop, quality, state) are processed eight entries at a
+ * time with 64-bit SIMD-within-a-register arithmetic, which works on every
+ * platform and in every build profile. The remaining entries are handled
+ * one by one.
+ */
+namespace NeighborScan {
+
+/**
+ * \param values byte column
+ * \param n number of entries
+ * \param value byte to look for
+ * \returns true if any entry equals value
+ */
+bool AnyEqual (const uint8_t *values, uint32_t n, uint8_t value);
+
+/**
+ * \brief Decrement every entry greater than zero
+ * \param values byte column
+ * \param n number of entries
+ */
+void DecrementNonZero (uint8_t *values, uint32_t n);
+
+/**
+ * \brief Collect the positions where both columns are zero
+ * \param a first byte column
+ * \param b second byte column
+ * \param n number of entries
+ * \param positions receives the positions, in increasing order
+ */
+void CollectBothZero (const uint8_t *a, const uint8_t *b, uint32_t n,
+                      std::vector<uint32_t> &positions);
+
+/**
+ * \brief Collect the positions whose value is lower than a limit
+ * \param values double column
+ * \param n number of entries
+ * \param limit exclusive upper limit
+ * \param positions receives the positions, in increasing order
+ */
+void CollectBelow (const double *values, uint32_t n, double limit,
+                   std::vector<uint32_t> &positions);
+
+} // namespace NeighborScan
+
+} // namespace ns3
+
+#endif /* NEIGHBOR_SCAN_H */
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include "neighbor-snapshot.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+NeighborSnapshot::NeighborSnapshot (uint64_t version, std::vector<struct FlySafeNeighborTable::Neighbor> &neighbors)
+  : m_version (version)
+{
+  m_neighbors.swap (neighbors);
+}
+
+uint64_t
+NeighborSnapshot::GetVersion (void) const
+{
+  return m_version;
+}
+
+uint32_t
+NeighborSnapshot::GetN (void) const
+{
+  return m_neighbors.size ();
+}
+
+const struct FlySafeNeighborTable::Neighbor &
+NeighborSnapshot::Get (uint32_t i) const
+{
+  NS_ASSERT_MSG (i < m_neighbors.size (), "NeighborSnapshot index " << i << " out of range");
+  return m_neighbors[i];
+}
+
+const std::vector<struct FlySafeNeighborTable::Neighbor> &
+NeighborSnapshot::GetNeighbors (void) const
+{
+  return m_neighbors;
+}
+
+NeighborSnapshot::const_iterator
+NeighborSnapshot::begin (void) const
+{
+  return m_neighbors.begin ();
+}
+
+NeighborSnapshot::const_iterator
+NeighborSnapshot::end (void) const
+{
+  return m_neighbors.end ();
+}
+
+} // namespace ns3
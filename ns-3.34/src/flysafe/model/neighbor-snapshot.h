@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef NEIGHBOR_SNAPSHOT_H
+#define NEIGHBOR_SNAPSHOT_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/simple-ref-count.h"
+#include "flysafe-neighbor-table.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Immutable copy of a node neighbor table.
+ *
+ * FlySafeNeighborTable::GetNeighborSnapshot hands out the same snapshot
+ * until the table changes, so trace sources can pass it to every sink by
+ * pointer instead of copying the table for each trace.
+ */
+class NeighborSnapshot : public SimpleRefCount<NeighborSnapshot>
+{
+public:
+  /// Iterator over the neighbor entries
+  typedef std::vector<struct FlySafeNeighborTable::Neighbor>::const_iterator const_iterator;
+
+  /**
+   * \brief Create a snapshot, taking the entries
+   * \param version the neighbor table version the entries belong to
+   * \param neighbors the entries, left empty
+   */
+  NeighborSnapshot (uint64_t version, std::vector<struct FlySafeNeighborTable::Neighbor> &neighbors);
+
+  /// \returns the neighbor table version of the snapshot
+  uint64_t GetVersion (void) const;
+
+  /// \returns the number of neighbors
+  uint32_t GetN (void) const;
+
+  /**
+   * \param i the position of the neighbor
+   * \returns the neighbor entry
+   */
+  const struct FlySafeNeighborTable::Neighbor &Get (uint32_t i) const;
+
+  /// \returns all the neighbor entries, in neighbor table order
+  const std::vector<struct FlySafeNeighborTable::Neighbor> &GetNeighbors (void) const;
+
+  /// \returns an iterator to the first neighbor
+  const_iterator begin (void) const;
+
+  /// \returns an iterator past the last neighbor
+  const_iterator end (void) const;
+
+private:
+  uint64_t m_version;                            //!< neighbor table version
+  std::vector<struct FlySafeNeighborTable::Neighbor> m_neighbors; //!< neighbor entries
+};
+
+} // namespace ns3
+
+#endif /* NEIGHBOR_SNAPSHOT_H */
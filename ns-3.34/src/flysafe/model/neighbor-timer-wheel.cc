@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <limits>
+
+#include "neighbor-timer-wheel.h"
+
+namespace ns3 {
+
+const uint32_t NeighborTimerWheel::LEVEL_BITS;
+const uint32_t NeighborTimerWheel::SLOTS;
+const uint32_t NeighborTimerWheel::LEVELS;
+
+NeighborTimerWheel::NeighborTimerWheel ()
+  : m_now (0),
+    m_size (0)
+{
+}
+
+void
+NeighborTimerWheel::Schedule (Ipv4Address ip, uint64_t deadline)
+{
+  Entry entry;
+  entry.ip = ip;
+  entry.deadline = deadline > m_now ? deadline : m_now + 1;
+  Place (entry);
+  m_size++;
+}
+
+void
+NeighborTimerWheel::Place (const Entry &entry)
+{
+  uint64_t delta = entry.deadline - m_now;
+  uint64_t slotTick = entry.deadline;
+  uint32_t level = 0;
+  while (level < LEVELS - 1 && delta >= (uint64_t (1) << (LEVEL_BITS * (level + 1))))
+    {
+      level++;
+    }
+  uint64_t horizon = uint64_t (1) << (LEVEL_BITS * LEVELS);
+  if (delta >= horizon)
+    {
+      // Beyond the wheel: wait in the farthest top level slot
+      slotTick = m_now + horizon - 1;
+    }
+  m_slots[level][(slotTick >> (LEVEL_BITS * level)) & (SLOTS - 1)].push_back (entry);
+}
+
+void
+NeighborTimerWheel::Cascade (uint32_t level)
+{
+  std::vector<Entry> entries;
+  entries.swap (m_slots[level][(m_now >> (LEVEL_BITS * level)) & (SLOTS - 1)]);
+  for (std::vector<Entry>::const_iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      Place (*i);
+    }
+}
+
+void
+NeighborTimerWheel::Advance (uint64_t now, std::vector<Entry> &expired)
+{
+  if (m_size == 0)
+    {
+      m_now = now > m_now ? now : m_now;
+      return;
+    }
+  while (m_now < now && m_size > 0)
+    {
+      m_now++;
+      // Upper levels first, so entries due now reach level 0 in time
+      for (uint32_t level = LEVELS - 1; level > 0; level--)
+        {
+          if ((m_now & ((uint64_t (1) << (LEVEL_BITS * level)) - 1)) == 0)
+            {
+              Cascade (level);
+            }
+        }
+      std::vector<Entry> &slot = m_slots[0][m_now & (SLOTS - 1)];
+      m_size -= slot.size ();
+      expired.insert (expired.end (), slot.begin (), slot.end ());
+      slot.clear ();
+    }
+  m_now = now > m_now ? now : m_now;
+}
+
+uint64_t
+NeighborTimerWheel::GetNow (void) const
+{
+  return m_now;
+}
+
+uint32_t
+NeighborTimerWheel::GetSize (void) const
+{
+  return m_size;
+}
+
+uint64_t
+NeighborTimerWheel::GetNextTick (void) const
+{
+  uint64_t next = std::numeric_limits<uint64_t>::max ();
+  if (m_size == 0)
+    {
+      return next;
+    }
+  // Level 0 entries are due within a turn of its slots
+  for (uint64_t tick = m_now + 1; tick <= m_now + SLOTS; tick++)
+    {
+      if (!m_slots[0][tick & (SLOTS - 1)].empty ())
+        {
+          next = tick;
+          break;
+        }
+    }
+  // Upper level entries are not due before their slot is cascaded
+  for (uint32_t level = 1; level < LEVELS; level++)
+    {
+      uint32_t shift = LEVEL_BITS * level;
+      for (uint64_t period = (m_now >> shift) + 1; period <= (m_now >> shift) + SLOTS; period++)
+        {
+          if ((period << shift) >= next)
+            {
+              break;
+            }
+          if (!m_slots[level][period & (SLOTS - 1)].empty ())
+            {
+              next = period << shift;
+              break;
+            }
+        }
+    }
+  return next;
+}
+
+void
+NeighborTimerWheel::Clear (void)
+{
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      for (uint32_t slot = 0; slot < SLOTS; slot++)
+        {
+          m_slots[level][slot].clear ();
+        }
+    }
+  m_size = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef NEIGHBOR_TIMER_WHEEL_H
+#define NEIGHBOR_TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Hierarchical timer wheel of neighbor expiry deadlines.
+ *
+ * Deadlines are integer ticks. Four levels of 64 slots cover 2^24 ticks
+ * ahead of the current tick; later deadlines wait in the last slot of the
+ * top level and are placed again when it is reached. Scheduling is O(1)
+ * and every entry is moved at most once per level before it expires, so
+ * advancing the wheel costs O(1) per elapsed tick plus O(1) per entry.
+ *
+ * Entries are never cancelled. The owner keeps the authoritative
+ * deadline of each address and ignores or re-schedules stale entries
+ * when they expire.
+ */
+class NeighborTimerWheel
+{
+public:
+  /// A scheduled deadline
+  struct Entry
+  {
+    Ipv4Address ip;    //!< neighbor address
+    uint64_t deadline; //!< expiry tick
+  };
+
+  NeighborTimerWheel ();
+
+  /**
+   * \brief Schedule an expiry
+   * \param ip the neighbor address
+   * \param deadline the expiry tick, deadlines not after the current
+   * tick expire on the next tick
+   */
+  void Schedule (Ipv4Address ip, uint64_t deadline);
+
+  /**
+   * \brief Move the current tick forward, collecting the expired entries
+   * \param now the new current tick
+   * \param expired receives the entries whose deadline is not after now
+   *
+   * An empty wheel jumps directly to now.
+   */
+  void Advance (uint64_t now, std::vector<Entry> &expired);
+
+  /// \returns the current tick
+  uint64_t GetNow (void) const;
+
+  /// \returns the number of scheduled entries
+  uint32_t GetSize (void) const;
+
+  /**
+   * \returns the first tick after the current one at which Advance can
+   * return entries or move them down a level, the maximum value when empty
+   *
+   * Advancing to an earlier tick returns no entries.
+   */
+  uint64_t GetNextTick (void) const;
+
+  /// \brief Remove all the entries, keeping the current tick
+  void Clear (void);
+
+private:
+  /**
+   * \brief Store an entry in the slot matching its deadline
+   * \param entry the entry, its deadline is not before the current tick
+   */
+  void Place (const Entry &entry);
+
+  /**
+   * \brief Place again the entries of a slot of an upper level
+   * \param level the level, above 0
+   */
+  void Cascade (uint32_t level);
+
+  /// Bits of the tick handled by each level
+  static const uint32_t LEVEL_BITS = 6;
+  /// Slots per level
+  static const uint32_t SLOTS = 1 << LEVEL_BITS;
+  /// Number of levels
+  static const uint32_t LEVELS = 4;
+
+  std::vector<Entry> m_slots[LEVELS][SLOTS]; //!< entries of each slot
+  uint64_t m_now;                            //!< current tick
+  uint32_t m_size;                           //!< number of entries
+};
+
+} // namespace ns3
+
+#endif /* NEIGHBOR_TIMER_WHEEL_H */
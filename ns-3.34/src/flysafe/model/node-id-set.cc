@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <algorithm>
+
+#include "node-id-set.h"
+
+namespace ns3 {
+
+/**
+ * \param word 64 bits
+ * \returns the number of bits set in word
+ */
+static inline uint32_t
+CountBits (uint64_t word)
+{
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return (word * 0x0101010101010101ULL) >> 56;
+}
+
+NodeIdSet::NodeIdSet ()
+  : m_count (0)
+{
+}
+
+void
+NodeIdSet::Insert (uint32_t id)
+{
+  uint32_t w = id / 64;
+  if (w >= m_words.size ())
+    {
+      m_words.resize (w + 1, 0);
+    }
+  uint64_t bit = 1ULL << (id % 64);
+  m_count += (m_words[w] & bit) == 0;
+  m_words[w] |= bit;
+}
+
+void
+NodeIdSet::Erase (uint32_t id)
+{
+  uint32_t w = id / 64;
+  if (w < m_words.size ())
+    {
+      uint64_t bit = 1ULL << (id % 64);
+      m_count -= (m_words[w] & bit) != 0;
+      m_words[w] &= ~bit;
+    }
+}
+
+bool
+NodeIdSet::Contains (uint32_t id) const
+{
+  uint32_t w = id / 64;
+  return w < m_words.size () && (m_words[w] >> (id % 64)) & 1;
+}
+
+uint32_t
+NodeIdSet::GetCount (void) const
+{
+  return m_count;
+}
+
+uint32_t
+NodeIdSet::CountCommon (const NodeIdSet &other) const
+{
+  uint32_t n = std::min (m_words.size (), other.m_words.size ());
+  uint32_t count = 0;
+  for (uint32_t w = 0; w < n; w++)
+    {
+      count += CountBits (m_words[w] & other.m_words[w]);
+    }
+  return count;
+}
+
+void
+NodeIdSet::Clear (void)
+{
+  std::fill (m_words.begin (), m_words.end (), 0);
+  m_count = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef NODE_ID_SET_H
+#define NODE_ID_SET_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Bitset of dense node ids (see Ipv4AddressInterner).
+ *
+ * Membership costs one bit per possible id. Counting and intersecting
+ * sets work on 64 ids at a time.
+ */
+class NodeIdSet
+{
+public:
+  NodeIdSet ();
+
+  /**
+   * \brief Add an id, growing the set if needed
+   * \param id the id
+   */
+  void Insert (uint32_t id);
+
+  /**
+   * \brief Remove an id
+   * \param id the id
+   */
+  void Erase (uint32_t id);
+
+  /**
+   * \param id the id
+   * \returns true if the id is in the set
+   */
+  bool Contains (uint32_t id) const;
+
+  /// \returns the number of ids in the set
+  uint32_t GetCount (void) const;
+
+  /**
+   * \param other another set
+   * \returns the number of ids in both sets
+   */
+  uint32_t CountCommon (const NodeIdSet &other) const;
+
+  /// \brief Remove all the ids, keeping the allocated words
+  void Clear (void);
+
+private:
+  std::vector<uint64_t> m_words; //!< bit i of word w is id 64 * w + i
+  uint32_t m_count;              //!< number of ids in the set
+};
+
+} // namespace ns3
+
+#endif /* NODE_ID_SET_H */
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+
+#include <cmath>
+
+#include "ns3/assert.h"
+#include "position-grid.h"
+
+namespace ns3 {
+
+PositionGrid::PositionGrid (double cellSize)
+  : m_cellSize (cellSize),
+    m_size (0)
+{
+  NS_ASSERT_MSG (cellSize > 0, "PositionGrid cell size must be positive");
+}
+
+int64_t
+PositionGrid::GetCell (double coordinate) const
+{
+  return static_cast<int64_t> (std::floor (coordinate / m_cellSize));
+}
+
+uint64_t
+PositionGrid::GetKey (int64_t cx, int64_t cy)
+{
+  // Distant columns may share a key: they are then scanned together and
+  // the distance check keeps the results exact.
+  return (static_cast<uint64_t> (static_cast<uint32_t> (cx)) << 32) | static_cast<uint32_t> (cy);
+}
+
+void
+PositionGrid::Insert (uint32_t id, const Vector &position)
+{
+  Entry entry;
+  entry.id = id;
+  entry.x = position.x;
+  entry.y = position.y;
+  entry.z = position.z;
+  m_cells[GetKey (GetCell (position.x), GetCell (position.y))].push_back (entry);
+  m_size++;
+}
+
+bool
+PositionGrid::Remove (uint32_t id, const Vector &position)
+{
+  CellMap::iterator cell = m_cells.find (GetKey (GetCell (position.x), GetCell (position.y)));
+  if (cell == m_cells.end ())
+    {
+      return false;
+    }
+  std::vector<Entry> &entries = cell->second;
+  for (uint32_t i = 0; i < entries.size (); i++)
+    {
+      if (entries[i].id == id)
+        {
+          entries[i] = entries.back ();
+          entries.pop_back ();
+          if (entries.empty ())
+            {
+              m_cells.erase (cell); // Keep only occupied columns
+            }
+          m_size--;
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+PositionGrid::Move (uint32_t id, const Vector &from, const Vector &to)
+{
+  uint64_t key = GetKey (GetCell (to.x), GetCell (to.y));
+  if (key == GetKey (GetCell (from.x), GetCell (from.y)))
+    {
+      // Same column: update the entry in place
+      CellMap::iterator cell = m_cells.find (key);
+      if (cell != m_cells.end ())
+        {
+          for (std::vector<Entry>::iterator i = cell->second.begin (); i != cell->second.end (); i++)
+            {
+              if (i->id == id)
+                {
+                  i->x = to.x;
+                  i->y = to.y;
+                  i->z = to.z;
+                  return;
+                }
+            }
+        }
+    }
+  Remove (id, from);
+  Insert (id, to);
+}
+
+void
+PositionGrid::Collect (const std::vector<Entry> &cell, const Vector &center,
+                       double radius2, std::vector<uint32_t> &ids)
+{
+  for (std::vector<Entry>::const_iterator i = cell.begin (); i != cell.end (); i++)
+    {
+      double dx = i->x - center.x;
+      double dy = i->y - center.y;
+      double dz = i->z - center.z;
+      if (dx * dx + dy * dy + dz * dz <= radius2)
+        {
+          ids.push_back (i->id);
+        }
+    }
+}
+
+void
+PositionGrid::GetWithin (const Vector &center, double radius, std::vector<uint32_t> &ids) const
+{
+  if (radius < 0 || m_size == 0)
+    {
+      return;
+    }
+  double radius2 = radius * radius;
+  int64_t minX = GetCell (center.x - radius);
+  int64_t maxX = GetCell (center.x + radius);
+  int64_t minY = GetCell (center.y - radius);
+  int64_t maxY = GetCell (center.y + radius);
+
+  if ((double) (maxX - minX + 1) * (maxY - minY + 1) > m_cells.size ())
+    {
+      // Fewer occupied columns than columns in range: scan them all
+      for (CellMap::const_iterator cell = m_cells.begin (); cell != m_cells.end (); cell++)
+        {
+          Collect (cell->second, center, radius2, ids);
+        }
+      return;
+    }
+  for (int64_t cx = minX; cx <= maxX; cx++)
+    {
+      for (int64_t cy = minY; cy <= maxY; cy++)
+        {
+          CellMap::const_iterator cell = m_cells.find (GetKey (cx, cy));
+          if (cell != m_cells.end ())
+            {
+              Collect (cell->second, center, radius2, ids);
+            }
+        }
+    }
+}
+
+uint32_t
+PositionGrid::GetSize (void) const
+{
+  return m_size;
+}
+
+void
+PositionGrid::Clear (void)
+{
+  m_cells.clear ();
+  m_size = 0;
+}
+
+} // namespace ns3
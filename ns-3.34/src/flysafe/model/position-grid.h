@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * FlySafe Project
+ */
+#ifndef POSITION_GRID_H
+#define POSITION_GRID_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flysafe
+ *
+ * \brief Uniform grid of identified positions for range queries.
+ *
+ * Positions are bucketed in square columns of the x/y plane, as the
+ * swarm flies in a thin layer; z only counts in the distance. Only
+ * occupied columns are stored. With a column side close to the query
+ * radius, a range query visits nine columns and costs time proportional
+ * to the number of positions found around the center, whatever the size
+ * of the area.
+ */
+class PositionGrid
+{
+public:
+  /**
+   * \param cellSize the side of a column in meters
+   */
+  PositionGrid (double cellSize);
+
+  /**
+   * \brief Add a position
+   * \param id the identifier of the position, unique in the grid
+   * \param position the position
+   */
+  void Insert (uint32_t id, const Vector &position);
+
+  /**
+   * \brief Remove a position
+   * \param id the identifier of the position
+   * \param position the position it was inserted or last moved at
+   * \returns true if the position was found
+   */
+  bool Remove (uint32_t id, const Vector &position);
+
+  /**
+   * \brief Change a position
+   * \param id the identifier of the position
+   * \param from the position it was inserted or last moved at
+   * \param to the new position
+   *
+   * An identifier not found at from is inserted at to.
+   */
+  void Move (uint32_t id, const Vector &from, const Vector &to);
+
+  /**
+   * \brief Find the positions within a sphere
+   * \param center the center of the sphere
+   * \param radius the radius of the sphere in meters
+   * \param ids receives the identifiers of the positions whose distance
+   * to center is not above radius, in no particular order
+   */
+  void GetWithin (const Vector &center, double radius, std::vector<uint32_t> &ids) const;
+
+  /// \returns the number of positions
+  uint32_t GetSize (void) const;
+
+  /// \brief Remove all the positions
+  void Clear (void);
+
+private:
+  /// A stored position
+  struct Entry
+  {
+    uint32_t id; //!< identifier
+    double x;    //!< x coordinate
+    double y;    //!< y coordinate
+    double z;    //!< z coordinate
+  };
+
+  /**
+   * \param coordinate a coordinate in meters
+   * \returns the column index along the coordinate axis
+   */
+  int64_t GetCell (double coordinate) const;
+
+  /**
+   * \param cx the column index along x
+   * \param cy the column index along y
+   * \returns the key of the column
+   */
+  static uint64_t GetKey (int64_t cx, int64_t cy);
+
+  /**
+   * \brief Collect the positions of a column within a sphere
+   * \param cell the column
+   * \param center the center of the sphere
+   * \param radius2 the squared radius of the sphere
+   * \param ids receives the identifiers
+   */
+  static void Collect (const std::vector<Entry> &cell, const Vector &center,
+                       double radius2, std::vector<uint32_t> &ids);
+
+  /// Occupied columns
+  typedef std::unordered_map<uint64_t, std::vector<Entry> > CellMap;
+
+  double m_cellSize; //!< side of a column
+  CellMap m_cells;   //!< occupied columns by key
+  uint32_t m_size;   //!< number of positions
+};
+
+} // namespace ns3
+
+#endif /* POSITION_GRID_H */
@@ -3,13 +3,45 @@
 // Include a header file from your module to test.
 // #include "ns3/flysafe.h"
 
+#include <cmath>
+
 // An essential include is test.h
 #include "ns3/test.h"
 
+#include "ns3/flysafe-neighbor-table.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/flysafe-tag.h"
+#include "ns3/flysafe-header.h"
+#include "ns3/flysafe-statistics.h"
+#include "ns3/flysafe-packet-sink.h"
+#include "ns3/simple-net-device-helper.h"
+
 // Do not put your test classes in namespace ns3.  You may find it useful
 // to use the using directive to access the ns3 namespace directly
 using namespace ns3;
 
+// NL entries for a tag: n consecutive addresses from first, entry k at
+// origin + k * step, all with the same hop, state and information time
+static std::vector<MyTag::NeighInfos>
+MakeNeighInfos (uint32_t n, Ipv4Address first, Vector origin, Vector step,
+                uint8_t hop, uint8_t state, double infoTime)
+{
+  std::vector<MyTag::NeighInfos> entries (n);
+  for (uint32_t k = 0; k < n; k++)
+    {
+      entries[k].ip = Ipv4Address (first.Get () + k);
+      entries[k].x = origin.x + k * step.x;
+      entries[k].y = origin.y + k * step.y;
+      entries[k].z = origin.z + k * step.z;
+      entries[k].hop = hop;
+      entries[k].state = state;
+      entries[k].infoTime = infoTime;
+    }
+  return entries;
+}
+
 // This is an example TestCase.
 class FlySafeTestCase1 : public TestCase
 {
@@ -38,7 +70,7 @@ FlySafeTestCase1::~FlySafeTestCase1 ()
 // TestCase must implement
 //
 void
-StealthTestCase1::DoRun (void)
+FlySafeTestCase1::DoRun (void)
 {
   // A wide variety of test macros are available in src/core/test.h
   NS_TEST_ASSERT_MSG_EQ (true, true, "true doesn't equal true for some reason");
@@ -46,6 +78,863 @@ StealthTestCase1::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+// Neighbor and suspicious lists larger than 255 entries, as found in
+// swarms of a few hundred UAVs. Any 8-bit counter on these paths would
+// truncate the lists or never end a loop.
+class FlySafeLargeSwarmTestCase : public TestCase
+{
+public:
+  FlySafeLargeSwarmTestCase ();
+  virtual ~FlySafeLargeSwarmTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+/// Number of neighbors and suspects used by the large swarm test case
+static const uint32_t LARGE_SWARM_SIZE = 1000;
+
+FlySafeLargeSwarmTestCase::FlySafeLargeSwarmTestCase ()
+  : TestCase ("FlySafe NL, SL and tag with more than 255 entries")
+{
+}
+
+FlySafeLargeSwarmTestCase::~FlySafeLargeSwarmTestCase ()
+{
+}
+
+void
+FlySafeLargeSwarmTestCase::DoRun (void)
+{
+  Ipv4Address base ("10.0.0.1");
+  Ptr<FlySafeNeighborTable> node = CreateObject<FlySafeNeighborTable> ();
+  Ipv4Address self (base.Get () + LARGE_SWARM_SIZE);
+
+  // NL received from a neighbor, merged into an empty NL
+  std::vector<FlySafeNeighborTable::Neighbor> received;
+  for (uint32_t n = 0; n < LARGE_SWARM_SIZE; n++)
+    {
+      FlySafeNeighborTable::Neighbor entry;
+      entry.ip = Ipv4Address (base.Get () + n);
+      entry.position = Vector (n % 80, n / 80, 91);
+      entry.distance = 0;
+      entry.attitude = 0;
+      entry.quality = 3;
+      entry.hop = 1;
+      entry.state = 0;
+      entry.infoTime = 0;
+      received.push_back (entry);
+    }
+  NS_TEST_ASSERT_MSG_EQ (node->MergeNeighborList (received, Vector (0, 0, 91), self), LARGE_SWARM_SIZE,
+                         "Every received entry must be merged");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), (int) LARGE_SWARM_SIZE, "NL truncated");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNeighborSnapshot ()->GetN (), LARGE_SWARM_SIZE, "NL snapshot truncated");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNeighborHop (Ipv4Address (base.Get () + LARGE_SWARM_SIZE - 1)), 2,
+                         "Last merged entry lost");
+
+  // Distance query over the NL, against a scan of the received NL
+  uint32_t inRange = 0;
+  for (uint32_t n = 0; n < LARGE_SWARM_SIZE; n++)
+    {
+      inRange += std::ceil (CalculateDistance (Vector (0, 0, 91), received[n].position) * 100.0) / 100.0 < 10;
+    }
+  NS_TEST_ASSERT_MSG_EQ (node->GetNeighborsCloserThan (10).size (), inRange, "Wrong neighbors in range");
+
+  // Merged entries have quality 1: a single aging round evicts all of them
+  NS_TEST_ASSERT_MSG_EQ (node->AgeAndEvictNeighbors ().size (), LARGE_SWARM_SIZE, "NL not fully evicted");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), 0, "NL not empty after eviction");
+
+  // SL
+  for (uint32_t n = 0; n < LARGE_SWARM_SIZE; n++)
+    {
+      node->RegisterMaliciousNode (Ipv4Address (base.Get () + n), self);
+    }
+  NS_TEST_ASSERT_MSG_EQ (node->GetNMaliciousNodes (), LARGE_SWARM_SIZE, "SL truncated");
+  NS_TEST_ASSERT_MSG_EQ (node->GetMaliciousNodeIps ().size (), LARGE_SWARM_SIZE, "SL view truncated");
+  NS_TEST_ASSERT_MSG_EQ (node->IsAMaliciousNode (Ipv4Address (base.Get () + LARGE_SWARM_SIZE - 1)), true,
+                         "Last suspect lost");
+  node->ClearMaliciousNodeList ();
+
+  // NL carried in a tag
+  std::vector<MyTag::NeighInfos> infos = MakeNeighInfos (LARGE_SWARM_SIZE, base, Vector (0, 0, 91), Vector (1, 2, 0), 1, 0, 1.5);
+  for (uint32_t n = 1; n < LARGE_SWARM_SIZE; n += 2)
+    {
+      infos[n].state = 1;
+    }
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetNNeighbors (infos.size ());
+  tag.SetPosition (Vector (1, 2, 3));
+  tag.SetMessageTime (1.5);
+  tag.SetNeighInfosVector (infos);
+  Ptr<Packet> packet = Create<Packet> (5);
+  packet->AddPacketTag (tag);
+
+  MyTag receivedTag;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (receivedTag), true, "Tag not found");
+  std::vector<MyTag::NeighInfos> receivedInfos = receivedTag.GetNeighInfosVector ();
+  NS_TEST_ASSERT_MSG_EQ (receivedTag.GetNNeighbors (), LARGE_SWARM_SIZE, "Tag NL size truncated");
+  NS_TEST_ASSERT_MSG_EQ (receivedInfos.size (), LARGE_SWARM_SIZE, "Tag NL truncated");
+  NS_TEST_ASSERT_MSG_EQ (receivedInfos.back ().ip, infos.back ().ip, "Last tag entry corrupted");
+  NS_TEST_ASSERT_MSG_EQ_TOL (receivedInfos.back ().y, infos.back ().y, 1e-9, "Last tag entry corrupted");
+
+  // Possible neighbors among all the nodes of the simulation
+  Statistics statistics ("", "");
+  std::vector<Statistics::NeighInfos> positions;
+  for (uint32_t n = 0; n < LARGE_SWARM_SIZE; n++)
+    {
+      Statistics::NeighInfos position;
+      position.ip = Ipv4Address (base.Get () + n);
+      position.x = 1 + n % 50; // Always in range
+      position.y = 0;
+      position.z = 91;
+      position.hop = 1;
+      position.distance = 0;
+      position.state = 0;
+      positions.push_back (position);
+    }
+  NS_TEST_ASSERT_MSG_EQ (statistics.IdentifyPossibleNeighbors (Vector (0, 0, 91), positions).size (),
+                         LARGE_SWARM_SIZE, "Possible neighbors truncated");
+
+  // Every received entry is a possible neighbor: full awareness
+  std::vector<std::string> evaluation = statistics.EvaluateNeighborhood (self, received, positions, 0);
+  NS_TEST_ASSERT_MSG_EQ (evaluation[1], std::string ("1000\t1000\t1000\t0\t1"), "Wrong neighborhood evaluation");
+
+  Simulator::Destroy ();
+}
+
+// Neighbors that are no longer heard must leave the NL once NeighborMaxAge
+// has elapsed, without any aging round driven by the application.
+class FlySafeNeighborExpiryTestCase : public TestCase
+{
+public:
+  FlySafeNeighborExpiryTestCase ();
+  virtual ~FlySafeNeighborExpiryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeNeighborExpiryTestCase::FlySafeNeighborExpiryTestCase ()
+  : TestCase ("FlySafe NL time-based expiry")
+{
+}
+
+FlySafeNeighborExpiryTestCase::~FlySafeNeighborExpiryTestCase ()
+{
+}
+
+void
+FlySafeNeighborExpiryTestCase::DoRun (void)
+{
+  Ipv4Address silent ("10.0.0.1");
+  Ipv4Address suspect ("10.0.0.2");
+  Ipv4Address heard ("10.0.0.3");
+  Ptr<FlySafeNeighborTable> node = CreateObject<FlySafeNeighborTable> ();
+  node->SetAttribute ("NeighborMaxAge", TimeValue (Seconds (1)));
+  NS_TEST_ASSERT_MSG_EQ (node->IsNeighborExpiryEnabled (), true, "Expiry not enabled");
+
+  node->RegisterNeighbor (silent, Vector (0, 0, 91), 10, 0, 3, 1, 0);
+  node->RegisterNeighbor (suspect, Vector (0, 0, 91), 10, 0, 3, 1, 1);
+  node->RegisterNeighbor (heard, Vector (0, 0, 91), 10, 0, 3, 1, 0);
+
+  // No wheel tick is due before 1 s: only the stop event runs
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Stop (Seconds (0.8));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetEventCount () - events, 1, "Expiry events before any deadline");
+  node->UpdateNeighbor (heard, Vector (0, 0, 91), 10, 0, 3, 1);
+  NS_TEST_ASSERT_MSG_EQ_TOL (node->GetNeighborInfoTime (heard), 0.8, 1e-9, "Information time not refreshed");
+
+  Simulator::Stop (Seconds (0.45));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (silent), false, "Silent neighbor not expired");
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (suspect), true, "Suspicious neighbor expired");
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (heard), true, "Refreshed neighbor expired");
+
+  Simulator::Stop (Seconds (0.75));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (heard), false, "Refreshed neighbor never expired");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), 1, "Only the suspicious neighbor must remain");
+
+  node->ClearNeighborList ();
+  Simulator::Destroy ();
+}
+
+// A full NL only admits an entry better than its worst one, and never
+// drops a suspicious entry while an ordinary one is left.
+class FlySafeNeighborCapacityTestCase : public TestCase
+{
+public:
+  FlySafeNeighborCapacityTestCase ();
+  virtual ~FlySafeNeighborCapacityTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeNeighborCapacityTestCase::FlySafeNeighborCapacityTestCase ()
+  : TestCase ("FlySafe NL capacity and eviction")
+{
+}
+
+FlySafeNeighborCapacityTestCase::~FlySafeNeighborCapacityTestCase ()
+{
+}
+
+void
+FlySafeNeighborCapacityTestCase::DoRun (void)
+{
+  Ipv4Address near ("10.0.0.1");
+  Ipv4Address far ("10.0.0.2");
+  Ipv4Address suspect ("10.0.0.3");
+  Ptr<FlySafeNeighborTable> node = CreateObject<FlySafeNeighborTable> ();
+  node->SetAttribute ("MaxNeighbors", UintegerValue (3));
+
+  node->RegisterNeighbor (near, Vector (0, 0, 91), 10, 0, 3, 1, 0);
+  node->RegisterNeighbor (far, Vector (0, 0, 91), 60, 0, 3, 1, 0);
+  node->RegisterNeighbor (suspect, Vector (0, 0, 91), 80, 0, 2, 1, 1);
+
+  // A multi-hop entry learned from a neighbor is staler than any entry
+  NS_TEST_ASSERT_MSG_EQ (node->RegisterNeighbor (Ipv4Address ("10.0.0.4"), Vector (0, 0, 91), 5, 0, 1, 2, 0), false,
+                         "Stale entry admitted in a full NL");
+  std::vector<FlySafeNeighborTable::Neighbor> received (1);
+  received[0].ip = Ipv4Address ("10.0.0.5");
+  received[0].position = Vector (1, 1, 91);
+  received[0].hop = 1;
+  received[0].state = 0;
+  received[0].infoTime = 0;
+  NS_TEST_ASSERT_MSG_EQ (node->MergeNeighborList (received, Vector (0, 0, 91), Ipv4Address ("10.0.0.9")), 0,
+                         "Merge overflowed a full NL");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), 3, "NL grew past its capacity");
+
+  // A fresh 1 hop neighbor replaces the farthest ordinary entry
+  Ipv4Address heard ("10.0.0.6");
+  NS_TEST_ASSERT_MSG_EQ (node->RegisterNeighbor (heard, Vector (0, 0, 91), 20, 0, 3, 1, 0), true,
+                         "Fresh entry rejected");
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (far), false, "Farthest entry not evicted");
+  NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (suspect), true, "Suspicious entry evicted");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), 3, "NL grew past its capacity");
+
+  // A merge into a full NL keeps the best entries of the NL and the received
+  // NL together, received entries also evicting each other
+  node->ClearNeighborList ();
+  for (uint32_t n = 0; n < 3; n++)
+    {
+      node->RegisterNeighbor (Ipv4Address (Ipv4Address ("10.0.1.1").Get () + n), Vector (70 + n * 10, 0, 91),
+                              70 + n * 10, 0, 1, 2, 0);
+    }
+  received.clear ();
+  for (uint32_t n = 0; n < 5; n++)
+    {
+      FlySafeNeighborTable::Neighbor entry;
+      entry.ip = Ipv4Address (Ipv4Address ("10.0.2.1").Get () + n);
+      entry.position = Vector (50 - n * 10, 0, 91); // Nearest last
+      entry.hop = 1;
+      entry.state = 0;
+      entry.infoTime = 0;
+      received.push_back (entry);
+    }
+  NS_TEST_ASSERT_MSG_EQ (node->MergeNeighborList (received, Vector (0, 0, 91), Ipv4Address ("10.0.0.9")), 3,
+                         "Wrong number of entries merged in a full NL");
+  NS_TEST_ASSERT_MSG_EQ (node->GetNNeighbors (), 3, "NL grew past its capacity");
+  for (uint32_t n = 2; n < 5; n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (node->IsAlreadyNeighbor (received[n].ip), true, "Nearer received entry not kept");
+    }
+
+  node->ClearNeighborList ();
+  Simulator::Destroy ();
+}
+
+// MyTag is written field by field: its size does not depend on the
+// struct padding, and every field survives the trip through a packet.
+class FlySafeTagEncodingTestCase : public TestCase
+{
+public:
+  FlySafeTagEncodingTestCase ();
+  virtual ~FlySafeTagEncodingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeTagEncodingTestCase::FlySafeTagEncodingTestCase ()
+  : TestCase ("FlySafe MyTag packed encoding")
+{
+}
+
+FlySafeTagEncodingTestCase::~FlySafeTagEncodingTestCase ()
+{
+}
+
+void
+FlySafeTagEncodingTestCase::DoRun (void)
+{
+  std::vector<MyTag::NeighInfos> entries = MakeNeighInfos (3, Ipv4Address ("10.0.0.1"), Vector (0, -20.25, 91), Vector (10.5, 0, 0), 1, 0, 12.5);
+  for (uint32_t n = 0; n < entries.size (); n++)
+    {
+      entries[n].hop = n + 1;
+      entries[n].state = n % 2;
+      entries[n].infoTime -= n * 0.25;
+    }
+
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetMessageTime (12.5);
+  tag.SetNNeighbors (entries.size ());
+  tag.SetPosition (Vector (1, 2, 91));
+  tag.SetNeighInfosVector (entries);
+  // 42 bytes of header, 32 bytes per neighbor
+  NS_TEST_ASSERT_MSG_EQ (tag.GetSerializedSize (), 42 + 32 * 3, "Padding left in the tag");
+
+  Ptr<Packet> packet = Create<Packet> (10);
+  packet->AddPacketTag (tag);
+  MyTag received;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ ((int) received.GetSimpleValue (), 2, "Wrong tag value");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetMessageTime (), 12.5, 1e-12, "Wrong message time");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNNeighbors (), 3, "Wrong number of neighbors");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetPosition ().y, 2, 1e-12, "Wrong position");
+
+  std::vector<MyTag::NeighInfos> decoded = received.GetNeighInfosVector ();
+  NS_TEST_ASSERT_MSG_EQ (decoded.size (), entries.size (), "Wrong number of entries");
+  for (uint32_t n = 0; n < decoded.size (); n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (decoded[n].ip, entries[n].ip, "Wrong neighbor address");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].x, entries[n].x, 1e-12, "Wrong neighbor position");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].y, entries[n].y, 1e-12, "Wrong neighbor position");
+      NS_TEST_ASSERT_MSG_EQ ((int) decoded[n].hop, (int) entries[n].hop, "Wrong neighbor hop");
+      NS_TEST_ASSERT_MSG_EQ ((int) decoded[n].state, (int) entries[n].state, "Wrong neighbor state");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].infoTime, entries[n].infoTime, 0.005, "Wrong neighbor information age");
+    }
+
+  // Relative encoding: sender position in centimeters, neighbors as
+  // decimeter offsets from it, within the positioning target
+  tag.SetPositionEncoding (MyTag::POSITION_RELATIVE);
+  NS_TEST_ASSERT_MSG_EQ (tag.GetSerializedSize (), 30 + 14 * 3, "Wrong relative tag size");
+  NS_TEST_ASSERT_MSG_LT (tag.GetQuantizationError (), 0.1, "Relative encoding too coarse");
+
+  Ptr<Packet> relativePacket = Create<Packet> (10);
+  relativePacket->AddPacketTag (tag);
+  NS_TEST_ASSERT_MSG_EQ (relativePacket->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.GetPositionEncoding (), MyTag::POSITION_RELATIVE, "Wrong encoding");
+  decoded = received.GetNeighInfosVector ();
+  NS_TEST_ASSERT_MSG_EQ (decoded.size (), entries.size (), "Wrong number of entries");
+  for (uint32_t n = 0; n < decoded.size (); n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].x, entries[n].x, 0.1, "Wrong relative neighbor position");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].y, entries[n].y, 0.1, "Wrong relative neighbor position");
+      NS_TEST_ASSERT_MSG_EQ ((int) decoded[n].hop, (int) entries[n].hop, "Wrong neighbor hop");
+    }
+}
+
+// Each NL entry carries the time its information was heard: a merge keeps
+// the freshest position, and a stale relay never overwrites it.
+class FlySafeNeighborFreshnessTestCase : public TestCase
+{
+public:
+  FlySafeNeighborFreshnessTestCase ();
+  virtual ~FlySafeNeighborFreshnessTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeNeighborFreshnessTestCase::FlySafeNeighborFreshnessTestCase ()
+  : TestCase ("FlySafe NL merge keeps the freshest entry")
+{
+}
+
+FlySafeNeighborFreshnessTestCase::~FlySafeNeighborFreshnessTestCase ()
+{
+}
+
+void
+FlySafeNeighborFreshnessTestCase::DoRun (void)
+{
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+
+  Ptr<FlySafeNeighborTable> node = CreateObject<FlySafeNeighborTable> ();
+  Ipv4Address self ("10.0.0.9");
+  Ipv4Address heard ("10.0.0.1");
+  Ipv4Address relayed ("10.0.0.2");
+  node->RegisterNeighbor (heard, Vector (10, 0, 91), 10, 0, 3, 1, 0); // Heard now, at 10 s
+
+  std::vector<FlySafeNeighborTable::Neighbor> received (3);
+  received[0].ip = heard;
+  received[0].position = Vector (50, 0, 91);
+  received[0].hop = 1;
+  received[0].state = 0;
+  received[0].infoTime = 8; // Older than the first-hand position
+  received[1].ip = relayed;
+  received[1].position = Vector (20, 0, 91);
+  received[1].hop = 1;
+  received[1].state = 0;
+  received[1].infoTime = 7;
+  received[2] = received[1];
+  received[2].position = Vector (30, 0, 91);
+  received[2].infoTime = 9; // Fresher duplicate of the same node
+  NS_TEST_ASSERT_MSG_EQ (node->MergeNeighborList (received, Vector (0, 0, 91), self), 1, "Stale entry merged");
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (node->GetNeighborPosition (heard).x, 10, 1e-9, "Stale relay overwrote a fresh position");
+  NS_TEST_ASSERT_MSG_EQ_TOL (node->GetNeighborPosition (relayed).x, 30, 1e-9, "Older duplicate kept");
+  NS_TEST_ASSERT_MSG_EQ_TOL (node->GetNeighborInfoTime (relayed), 9, 1e-9, "Relayed information made fresh");
+
+  received.resize (1);
+  received[0].ip = relayed;
+  received[0].position = Vector (40, 0, 91);
+  received[0].infoTime = 9.5;
+  NS_TEST_ASSERT_MSG_EQ (node->MergeNeighborList (received, Vector (0, 0, 91), self), 1, "Fresh entry not merged");
+  NS_TEST_ASSERT_MSG_EQ_TOL (node->GetNeighborPosition (relayed).x, 40, 1e-9, "Fresh relay ignored");
+
+  node->ClearNeighborList ();
+  Simulator::Destroy ();
+}
+
+// A relayed entry expires NeighborMaxAge after its information time, so
+// two nodes relaying a departed node to each other can not keep it alive.
+class FlySafeRelayedExpiryTestCase : public TestCase
+{
+public:
+  FlySafeRelayedExpiryTestCase ();
+  virtual ~FlySafeRelayedExpiryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeRelayedExpiryTestCase::FlySafeRelayedExpiryTestCase ()
+  : TestCase ("FlySafe NL relayed entries expire from their information time")
+{
+}
+
+FlySafeRelayedExpiryTestCase::~FlySafeRelayedExpiryTestCase ()
+{
+}
+
+void
+FlySafeRelayedExpiryTestCase::DoRun (void)
+{
+  Ipv4Address departed ("10.0.0.1");
+  Ipv4Address selfA ("10.0.0.8");
+  Ipv4Address selfB ("10.0.0.9");
+  Ptr<FlySafeNeighborTable> nodeA = CreateObject<FlySafeNeighborTable> ();
+  Ptr<FlySafeNeighborTable> nodeB = CreateObject<FlySafeNeighborTable> ();
+  nodeA->SetAttribute ("NeighborMaxAge", TimeValue (Seconds (1)));
+  nodeB->SetAttribute ("NeighborMaxAge", TimeValue (Seconds (1)));
+  nodeA->RegisterNeighbor (departed, Vector (10, 0, 91), 10, 0, 3, 1, 0); // Last heard at 0 s
+
+  // Both nodes exchange their full NL every 200 ms
+  for (uint32_t round = 1; round <= 10; round++)
+    {
+      Simulator::Stop (MilliSeconds (200));
+      Simulator::Run ();
+      std::vector<FlySafeNeighborTable::Neighbor> fromA;
+      std::vector<FlySafeNeighborTable::Neighbor> fromB;
+      for (int i = 0; i < nodeA->GetNNeighbors (); i++)
+        {
+          fromA.push_back (nodeA->GetNeighbor (i));
+        }
+      for (int i = 0; i < nodeB->GetNNeighbors (); i++)
+        {
+          fromB.push_back (nodeB->GetNeighbor (i));
+        }
+      nodeB->MergeNeighborList (fromA, Vector (0, 0, 91), selfB);
+      nodeA->MergeNeighborList (fromB, Vector (0, 0, 91), selfA);
+      if (round == 4)
+        {
+          NS_TEST_ASSERT_MSG_EQ (nodeB->IsAlreadyNeighbor (departed), true, "Relayed entry not merged");
+          NS_TEST_ASSERT_MSG_EQ_TOL (nodeB->GetNeighborInfoTime (departed), 0, 1e-9, "Relayed entry made fresh");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (nodeA->IsAlreadyNeighbor (departed), false, "Departed node kept alive by relays");
+  NS_TEST_ASSERT_MSG_EQ (nodeB->IsAlreadyNeighbor (departed), false, "Relayed entry outlived its information");
+
+  nodeA->ClearNeighborList ();
+  nodeB->ClearNeighborList ();
+  Simulator::Destroy ();
+}
+
+// Trap messages may carry only the NL entries added or changed since the
+// previous round, flagged as a delta NL in the tag.
+class FlySafeTagDeltaTestCase : public TestCase
+{
+public:
+  FlySafeTagDeltaTestCase ();
+  virtual ~FlySafeTagDeltaTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeTagDeltaTestCase::FlySafeTagDeltaTestCase ()
+  : TestCase ("FlySafe MyTag delta NL")
+{
+}
+
+FlySafeTagDeltaTestCase::~FlySafeTagDeltaTestCase ()
+{
+}
+
+void
+FlySafeTagDeltaTestCase::DoRun (void)
+{
+  std::vector<MyTag::NeighInfos> previous = MakeNeighInfos (5, Ipv4Address ("10.0.0.1"), Vector (0, 0, 91), Vector (10, 0, 0), 1, 0, 0);
+  std::vector<MyTag::NeighInfos> current (previous.begin () + 1, previous.end ()); // 10.0.0.1 was removed
+  previous.pop_back (); // 10.0.0.5 is new
+  current[0].x += 1; // 10.0.0.2 moved
+  current[1].state = 1; // 10.0.0.3 became suspicious
+
+  std::vector<MyTag::NeighInfos> changed = MyTag::GetChangedNeighInfos (previous, current);
+  NS_TEST_ASSERT_MSG_EQ (changed.size (), 3, "Wrong number of changed entries");
+  NS_TEST_ASSERT_MSG_EQ (changed[0].ip, Ipv4Address ("10.0.0.2"), "Moved entry missing");
+  NS_TEST_ASSERT_MSG_EQ (changed[1].ip, Ipv4Address ("10.0.0.3"), "Suspicious entry missing");
+  NS_TEST_ASSERT_MSG_EQ (changed[2].ip, Ipv4Address ("10.0.0.5"), "New entry missing");
+  NS_TEST_ASSERT_MSG_EQ (MyTag::GetChangedNeighInfos (current, current).size (), 0, "Unchanged NL sent");
+
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetNNeighbors (current.size ());
+  tag.SetNeighInfosVector (changed);
+  tag.SetDeltaList (true);
+  tag.SetPositionEncoding (MyTag::POSITION_CENTIMETERS);
+  Ptr<Packet> packet = Create<Packet> (5);
+  packet->AddPacketTag (tag);
+
+  MyTag received;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.IsDeltaList (), true, "Delta flag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.GetPositionEncoding (), MyTag::POSITION_CENTIMETERS, "Wrong encoding");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNNeighbors (), 4, "Wrong number of neighbors");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNeighInfosVector ().size (), 3, "Wrong number of entries");
+
+  // The received NL is moved out of the tag, not copied
+  std::vector<MyTag::NeighInfos> taken = received.TakeNeighInfosVector ();
+  NS_TEST_ASSERT_MSG_EQ (taken.size (), 3, "NL lost when taken from the tag");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNeighInfosVector ().empty (), true, "NL left in the tag");
+
+  // An entry only heard again is sent once its time moved by more than the
+  // bound, the shifts of the rounds it was not sent adding up
+  std::vector<MyTag::NeighInfos> heard = current;
+  std::vector<MyTag::NeighInfos> known;
+  heard[0].infoTime = 1; // 10.0.0.2 heard 1 s later
+  NS_TEST_ASSERT_MSG_EQ (MyTag::GetChangedNeighInfos (current, heard).size (), 0, "Time compared without a bound");
+  NS_TEST_ASSERT_MSG_EQ (MyTag::GetChangedNeighInfos (current, heard, 1.5, &known).size (), 0,
+                         "Entry sent before its time moved enough");
+  NS_TEST_ASSERT_MSG_EQ (known.size (), heard.size (), "Wrong receivers NL");
+  NS_TEST_ASSERT_MSG_EQ_TOL (known[0].infoTime, 0, 1e-12, "Receivers time replaced by an entry not sent");
+  heard[0].infoTime = 2;
+  std::vector<MyTag::NeighInfos> next;
+  changed = MyTag::GetChangedNeighInfos (known, heard, 1.5, &next);
+  NS_TEST_ASSERT_MSG_EQ (changed.size (), 1, "Entry heard again not sent");
+  NS_TEST_ASSERT_MSG_EQ (changed[0].ip, Ipv4Address ("10.0.0.2"), "Wrong entry heard again");
+  NS_TEST_ASSERT_MSG_EQ_TOL (next[0].infoTime, 2, 1e-12, "Receivers time of the entry sent not updated");
+}
+
+// Suspect, blocked and reduction notifications are sent as compact alerts:
+// no NL fields, quantized positions and several suspects per message.
+class FlySafeTagAlertTestCase : public TestCase
+{
+public:
+  FlySafeTagAlertTestCase ();
+  virtual ~FlySafeTagAlertTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeTagAlertTestCase::FlySafeTagAlertTestCase ()
+  : TestCase ("FlySafe MyTag compact alerts")
+{
+}
+
+FlySafeTagAlertTestCase::~FlySafeTagAlertTestCase ()
+{
+}
+
+void
+FlySafeTagAlertTestCase::DoRun (void)
+{
+  // False locations may be far from the notifier
+  std::vector<MyTag::NeighInfos> suspects = MakeNeighInfos (2, Ipv4Address ("10.0.0.7"), Vector (1400.37, 3.14, 91), Vector (-10, 0, 0), 1, 0, 7.25);
+  suspects[1].state = 1;
+
+  MyTag tag;
+  tag.SetSimpleValue (4);
+  tag.SetMessageTime (7.25);
+  tag.SetNNeighbors (suspects.size ());
+  tag.SetPosition (Vector (100.12, 200.46, 91));
+  tag.SetNeighInfosVector (suspects);
+  tag.SetAlertList (true);
+  // 23 bytes of header, 11 bytes per suspect, whatever the position encoding
+  NS_TEST_ASSERT_MSG_EQ (tag.GetSerializedSize (), 23 + 11 * 2, "Wrong alert size");
+  NS_TEST_ASSERT_MSG_LT (tag.GetQuantizationError (), 0.1, "Alert positions too coarse");
+
+  Ptr<Packet> packet = Create<Packet> (8);
+  packet->AddPacketTag (tag);
+  MyTag received;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.IsAlertList (), true, "Alert flag lost");
+  NS_TEST_ASSERT_MSG_EQ ((int) received.GetSimpleValue (), 4, "Wrong tag value");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetMessageTime (), 7.25, 1e-12, "Wrong message time");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetPosition ().x, 100.12, 0.005, "Wrong notifier position");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNNeighbors (), 2, "Wrong number of suspects");
+
+  const std::vector<MyTag::NeighInfos> &decoded = received.GetNeighInfosVector ();
+  NS_TEST_ASSERT_MSG_EQ (decoded.size (), suspects.size (), "Wrong number of entries");
+  for (uint32_t n = 0; n < decoded.size (); n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (decoded[n].ip, suspects[n].ip, "Wrong suspect address");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].x, suspects[n].x, 0.1, "Wrong suspect position");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].y, suspects[n].y, 0.1, "Wrong suspect position");
+      NS_TEST_ASSERT_MSG_EQ ((int) decoded[n].state, (int) suspects[n].state, "Wrong suspect state");
+      NS_TEST_ASSERT_MSG_EQ ((int) decoded[n].hop, 1, "Suspects are one hop from the notifier");
+      NS_TEST_ASSERT_MSG_EQ_TOL (decoded[n].infoTime, 7.25, 1e-12, "Wrong suspect information time");
+    }
+
+  // A batch larger than an alert is cut to its capacity
+  tag.SetNeighInfosVector (std::vector<MyTag::NeighInfos> (300, suspects[0]));
+  NS_TEST_ASSERT_MSG_EQ (tag.GetSerializedSize (), 23 + 11 * MyTag::MAX_ALERT_ENTRIES, "Alert over its capacity");
+}
+
+// With the header transport the message is in the packet bytes, so its
+// size is seen by the channel, and it reads back as the tag it carries.
+class FlySafeHeaderTestCase : public TestCase
+{
+public:
+  FlySafeHeaderTestCase ();
+  virtual ~FlySafeHeaderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeHeaderTestCase::FlySafeHeaderTestCase ()
+  : TestCase ("FlySafe header transport")
+{
+}
+
+FlySafeHeaderTestCase::~FlySafeHeaderTestCase ()
+{
+}
+
+void
+FlySafeHeaderTestCase::DoRun (void)
+{
+  std::vector<MyTag::NeighInfos> entries = MakeNeighInfos (40, Ipv4Address ("10.0.0.1"), Vector (0, 10, 91), Vector (2.5, 0, 0), 1, 0, 3);
+  for (uint32_t n = 1; n < entries.size (); n += 2)
+    {
+      entries[n].hop = 2;
+    }
+
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetMessageTime (3);
+  tag.SetNNeighbors (entries.size ());
+  tag.SetPosition (Vector (5, 5, 91));
+  tag.SetNeighInfosVector (entries);
+
+  Ptr<Packet> packet = Create<Packet> (0);
+  packet->AddHeader (FlySafeHeader (tag));
+  // 2 bytes of length before the tag bytes
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 2 + 42 + 32 * 40, "Message not in the packet bytes");
+  MyTag noTag;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (noTag), false, "Message sent as a tag too");
+
+  // Copies sent to each neighbor share the header bytes
+  Ptr<Packet> copy = packet->Copy ();
+  FlySafeHeader header;
+  NS_TEST_ASSERT_MSG_EQ (copy->RemoveHeader (header), packet->GetSize (), "Wrong header size");
+  NS_TEST_ASSERT_MSG_EQ (copy->GetSize (), 0, "Bytes left after the header");
+
+  const MyTag &received = header.GetTag ();
+  NS_TEST_ASSERT_MSG_EQ ((int) received.GetSimpleValue (), 2, "Wrong tag value");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetMessageTime (), 3, 1e-12, "Wrong message time");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNNeighbors (), 40, "Wrong number of neighbors");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNeighInfosVector ().size (), entries.size (), "Wrong number of entries");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNeighInfosVector ()[39].ip, entries[39].ip, "Wrong neighbor address");
+  NS_TEST_ASSERT_MSG_EQ_TOL (received.GetNeighInfosVector ()[39].x, entries[39].x, 1e-12, "Wrong neighbor position");
+
+  // Bytes that are not a whole message are read as no header
+  Ptr<Packet> payload = Create<Packet> (8);
+  NS_TEST_ASSERT_MSG_EQ (payload->PeekHeader (header), 0, "Payload read as a header");
+  Ptr<Packet> truncated = packet->CreateFragment (0, packet->GetSize () - 1);
+  NS_TEST_ASSERT_MSG_EQ (truncated->PeekHeader (header), 0, "Truncated header read");
+
+  // A NL of the most entries a header carries fits, one more does not
+  uint32_t maxNeighbors = FlySafeHeader::GetMaxNeighbors (MyTag::POSITION_DOUBLE);
+  NS_TEST_ASSERT_MSG_EQ (maxNeighbors, (FlySafeHeader::MAX_MESSAGE_SIZE - 42) / 32, "Wrong header capacity");
+  entries.resize (maxNeighbors, entries[0]);
+  tag.SetNeighInfosVector (entries);
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (tag.GetSerializedSize (), FlySafeHeader::MAX_MESSAGE_SIZE, "Largest NL does not fit");
+  entries.push_back (entries[0]);
+  tag.SetNeighInfosVector (entries);
+  NS_TEST_ASSERT_MSG_GT (tag.GetSerializedSize (), FlySafeHeader::MAX_MESSAGE_SIZE, "Header capacity too low");
+
+  // The NL of a node sending headers is limited to that capacity
+  Ptr<FlySafeNeighborTable> node = CreateObject<FlySafeNeighborTable> ();
+  node->LimitNeighbors (maxNeighbors);
+  UintegerValue capacity;
+  node->GetAttribute ("MaxNeighbors", capacity);
+  NS_TEST_ASSERT_MSG_EQ (capacity.Get (), maxNeighbors, "Unlimited NL not limited");
+  node->SetAttribute ("MaxNeighbors", UintegerValue (10));
+  node->LimitNeighbors (maxNeighbors);
+  node->GetAttribute ("MaxNeighbors", capacity);
+  NS_TEST_ASSERT_MSG_EQ (capacity.Get (), 10, "Smaller NL capacity raised");
+}
+
+// A broadcast trap marks its targets in the state of their NL entries:
+// no bytes are added and the receivers read back the original states.
+class FlySafeTrapTargetsTestCase : public TestCase
+{
+public:
+  FlySafeTrapTargetsTestCase ();
+  virtual ~FlySafeTrapTargetsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeTrapTargetsTestCase::FlySafeTrapTargetsTestCase ()
+  : TestCase ("FlySafe broadcast trap targets")
+{
+}
+
+FlySafeTrapTargetsTestCase::~FlySafeTrapTargetsTestCase ()
+{
+}
+
+void
+FlySafeTrapTargetsTestCase::DoRun (void)
+{
+  std::vector<MyTag::NeighInfos> entries = MakeNeighInfos (10, Ipv4Address ("10.0.0.1"), Vector (0, 20, 91), Vector (5, 0, 0), 1, 0, 4);
+  std::vector<Ipv4Address> targets;
+  for (uint32_t n = 0; n < entries.size (); n++)
+    {
+      entries[n].hop = 1 + n % 2;
+      entries[n].state = n % 3;
+      if (entries[n].hop == 1)
+        {
+          targets.push_back (entries[n].ip);
+        }
+    }
+
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetMessageTime (4);
+  tag.SetNNeighbors (entries.size ());
+  tag.SetPosition (Vector (0, 0, 91));
+  tag.SetNeighInfosVector (entries);
+  uint32_t unicastSize = tag.GetSerializedSize ();
+  tag.SetTrapTargets (targets);
+  NS_TEST_ASSERT_MSG_EQ (tag.GetSerializedSize (), unicastSize, "Targets must not add bytes");
+
+  Ptr<Packet> packet = Create<Packet> (8);
+  packet->AddPacketTag (tag);
+  MyTag received;
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.HasTrapTargets (), true, "Targets lost");
+  for (uint32_t n = 0; n < entries.size (); n++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (received.IsTrapTarget (entries[n].ip), entries[n].hop == 1, "Wrong trap target");
+      NS_TEST_ASSERT_MSG_EQ ((int) received.GetNeighInfosVector ()[n].state, (int) entries[n].state,
+                             "Target mark left in the state");
+    }
+  NS_TEST_ASSERT_MSG_EQ (received.IsTrapTarget (Ipv4Address ("10.0.1.1")), false, "Node out of the NL targeted");
+
+  // Unicast traps, sent with no targets, are for every receiver
+  tag.SetTrapTargets (std::vector<Ipv4Address> ());
+  packet = Create<Packet> (8);
+  packet->AddPacketTag (tag);
+  NS_TEST_ASSERT_MSG_EQ (packet->PeekPacketTag (received), true, "Tag lost");
+  NS_TEST_ASSERT_MSG_EQ (received.HasTrapTargets (), false, "Targets left from the last message");
+}
+
+// A broadcast trap is analyzed by its targets only: a neighbor that is
+// not marked in its NL drops it and does not learn about the sender.
+class FlySafeBroadcastTrapTestCase : public TestCase
+{
+public:
+  FlySafeBroadcastTrapTestCase ();
+  virtual ~FlySafeBroadcastTrapTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlySafeBroadcastTrapTestCase::FlySafeBroadcastTrapTestCase ()
+  : TestCase ("FlySafe broadcast trap dropped by non-targets")
+{
+}
+
+FlySafeBroadcastTrapTestCase::~FlySafeBroadcastTrapTestCase ()
+{
+}
+
+static void
+SendBroadcast (Ptr<Socket> socket, Ptr<Packet> packet)
+{
+  socket->SendTo (packet, 0, InetSocketAddress (Ipv4Address ("255.255.255.255"), 9));
+}
+
+void
+FlySafeBroadcastTrapTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3); // Sender, its target and a neighbor not targeted
+  SimpleNetDeviceHelper simple;
+  NetDeviceContainer devices = simple.Install (nodes);
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  for (uint32_t n = 0; n < nodes.GetN (); n++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (10 * n, 0, 91));
+      nodes.Get (n)->AggregateObject (mobility);
+      if (n == 0)
+        {
+          continue;
+        }
+      Ptr<FlySafePacketSink> sink = CreateObject<FlySafePacketSink> ();
+      nodes.Get (n)->AddApplication (sink);
+      sink->Setup (InetSocketAddress (Ipv4Address::GetAny (), 9), 1, 9999.99);
+    }
+
+  // NL of the sender: the other nodes, at their positions
+  std::vector<MyTag::NeighInfos> entries = MakeNeighInfos (nodes.GetN () - 1, interfaces.GetAddress (1), Vector (10, 0, 91), Vector (10, 0, 0), 1, 0, 1);
+
+  MyTag tag;
+  tag.SetSimpleValue (2);
+  tag.SetMessageTime (1);
+  tag.SetNNeighbors (entries.size ());
+  tag.SetPosition (Vector (0, 0, 91));
+  tag.SetNeighInfosVector (entries);
+  tag.SetTrapTargets (std::vector<Ipv4Address> (1, interfaces.GetAddress (1)));
+  Ptr<Packet> packet = Create<Packet> (8);
+  packet->AddPacketTag (tag);
+
+  Ptr<Socket> socket = Socket::CreateSocket (nodes.Get (0), UdpSocketFactory::GetTypeId ());
+  socket->SetAllowBroadcast (true);
+  socket->Bind ();
+  Simulator::Schedule (Seconds (1), &SendBroadcast, socket, packet);
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+
+  Ipv4Address sender = interfaces.GetAddress (0);
+  NS_TEST_ASSERT_MSG_EQ (nodes.Get (1)->GetObject<FlySafeNeighborTable> ()->IsAlreadyNeighbor (sender), true,
+                         "Trap not analyzed by its target");
+  NS_TEST_ASSERT_MSG_EQ (nodes.Get (2)->GetObject<FlySafeNeighborTable> ()->IsAlreadyNeighbor (sender), false,
+                         "Trap analyzed by a node it was not addressed to");
+  socket->Close ();
+  Simulator::Destroy ();
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -61,6 +950,17 @@ FlySafeTestSuite::FlySafeTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new FlySafeTestCase1, TestCase::QUICK);
+  AddTestCase (new FlySafeLargeSwarmTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeNeighborExpiryTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeNeighborCapacityTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeNeighborFreshnessTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeRelayedExpiryTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeTagEncodingTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeTagDeltaTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeTagAlertTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeHeaderTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeTrapTargetsTestCase, TestCase::QUICK);
+  AddTestCase (new FlySafeBroadcastTrapTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite